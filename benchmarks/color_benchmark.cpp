@@ -0,0 +1,685 @@
+// color_converter kütüphanesi için Google Benchmark ölçümleri.
+//
+// JSON çıktı için:
+//   ./color_bench --benchmark_format=json --benchmark_out=color_bench.json
+// 100 Mpx ölçümleri çok bellek ister; yalnızca COLOR_BENCH_LARGE=1 ile açılır.
+
+#include "color/ColorConverter.hpp"
+#include "color/ColorTypes.hpp"
+#include "color/ConversionJob.hpp"
+#include "color/Converter.hpp"
+#include "color/ImageColorConverter.hpp"
+#include "color/ImageReader.hpp"
+#include "color/InkStatistics.hpp"
+#include "color/MappedFile.hpp"
+#include "color/SoftProofer.hpp"
+#include "color/ThreadPool.hpp"
+#include "color/TileCache.hpp"
+#include "color/TransformCache.hpp"
+#include "color/UniqueColorCache.hpp"
+#include "stb_image.h"
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+    const std::string kResourceDir = COLOR_RESOURCE_DIR;
+    const std::string kRgbProfile = kResourceDir + "/icc_profiles/sRGB.icc";
+    const std::string kCmykProfile = kResourceDir + "/icc_profiles/output_CMYK.icc";
+    const std::string kTestImage = kResourceDir + "/images/test.png";
+
+    // Cache'e takılmayan, tekrar üretilebilir gürültü
+    template <typename Pixel>
+    std::vector<Pixel> noise(size_t count) {
+        std::vector<Pixel> pixels(count);
+        uint32_t state = 12345;
+        auto* bytes = reinterpret_cast<uint8_t*>(pixels.data());
+        for (size_t i = 0; i < count * sizeof(Pixel); ++i) {
+            state = state * 1664525u + 1013904223u;
+            bytes[i] = static_cast<uint8_t>(state >> 24);
+        }
+        return pixels;
+    }
+
+    void setThroughput(benchmark::State& state, size_t pixels) {
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(pixels));
+        state.counters["Mpx/s"] = benchmark::Counter(
+            static_cast<double>(pixels) * state.iterations() / 1e6, benchmark::Counter::kIsRate);
+    }
+
+    bool initConverter(benchmark::State& state, ColorConverter& converter,
+                       const ConversionOptions& options = ConversionOptions()) {
+        if (!converter.initialize(kRgbProfile, kCmykProfile, options)) {
+            state.SkipWithError("ICC profilleri yüklenemedi");
+            return false;
+        }
+        return true;
+    }
+
+    // Görüntü boyutu (kenar uzunluğu) ve thread sayısına göre piksel verimi
+    template <typename In, typename Out>
+    void BM_Convert(benchmark::State& state) {
+        const size_t side = static_cast<size_t>(state.range(0));
+        const size_t pixels = side * side;
+
+        ColorConverter converter;
+        if (!initConverter(state, converter)) return;
+        converter.setThreadCount(static_cast<unsigned>(state.range(1)));
+
+        std::vector<In> input = noise<In>(pixels);
+        std::vector<Out> output(pixels);
+        for (auto _ : state) {
+            converter.convert(input.data(), output.data(), pixels);
+            benchmark::DoNotOptimize(output.data());
+            benchmark::ClobberMemory();
+        }
+        setThroughput(state, pixels);
+    }
+
+    // Ayrı C/M/Y/K düzlemleri: 0 = bitişik dönüşüm + ayrıştırma geçişi,
+    // 1 = convertPlanar (lcms), 2 = convertPlanar (33'lük LUT)
+    void BM_Planar(benchmark::State& state) {
+        const size_t pixels = 2048 * 2048;
+        ConversionOptions options;
+        if (state.range(0) == 2) options.lutGridPoints = 33;
+
+        ColorConverter converter;
+        if (!initConverter(state, converter, options)) return;
+
+        std::vector<RGB8> input = noise<RGB8>(pixels);
+        std::vector<uint16_t> planes(4 * pixels);
+        CMYKPlanes output = {{planes.data(), planes.data() + pixels,
+                              planes.data() + 2 * pixels, planes.data() + 3 * pixels}};
+        std::vector<CMYK16> interleaved(state.range(0) == 0 ? pixels : 0);
+        for (auto _ : state) {
+            if (state.range(0) == 0) {
+                converter.convert(input.data(), interleaved.data(), pixels);
+                for (size_t i = 0; i < pixels; ++i) {
+                    planes[i] = interleaved[i].c;
+                    planes[pixels + i] = interleaved[i].m;
+                    planes[2 * pixels + i] = interleaved[i].y;
+                    planes[3 * pixels + i] = interleaved[i].k;
+                }
+            } else {
+                converter.convertPlanar(input.data(), PixelFormat::RGB8, output, PixelFormat::CMYK16, pixels);
+            }
+            benchmark::DoNotOptimize(planes.data());
+            benchmark::ClobberMemory();
+        }
+        setThroughput(state, pixels);
+    }
+
+    // Dolgulu 4096'lık framebuffer'da range(0) kenarlı kirli bölgenin yeniden dönüşümü
+    void BM_Region(benchmark::State& state) {
+        const size_t side = 4096;
+        const size_t inStride = side * sizeof(RGBA8) + 64;
+        const size_t outStride = side * sizeof(CMYK16) + 64;
+        const size_t edge = static_cast<size_t>(state.range(0));
+
+        ColorConverter converter;
+        if (!initConverter(state, converter)) return;
+
+        std::vector<uint8_t> input = noise<uint8_t>(inStride * side);
+        std::vector<uint8_t> output(outStride * side);
+        const PixelRect region{1000, 1000, edge, edge};
+        for (auto _ : state) {
+            converter.convert(input.data(), PixelFormat::RGBA8, inStride,
+                              output.data(), PixelFormat::CMYK16, outStride,
+                              side, side, region);
+            benchmark::DoNotOptimize(output.data());
+            benchmark::ClobberMemory();
+        }
+        setThroughput(state, edge * edge);
+    }
+
+    // Mürekkep istatistiği (TAC %300 sınırı, histogramlar): 0 = yalnızca dönüşüm,
+    // 1 = dönüşüm + çıktı üzerinde ayrı geçiş, 2 = dönüşümle aynı geçişte
+    void BM_InkStats(benchmark::State& state) {
+        const size_t pixels = 4096 * 2048;
+        ColorConverter converter;
+        if (!initConverter(state, converter)) return;
+        converter.setThreadCount(0);
+
+        std::vector<RGB8> input = noise<RGB8>(pixels);
+        std::vector<CMYK16> output(pixels);
+        InkOptions ink;
+        ink.tacLimit = 300.0;
+        InkStats stats;
+        for (auto _ : state) {
+            if (state.range(0) == 2) {
+                converter.convert(input.data(), output.data(), pixels, ink, stats);
+            } else {
+                converter.convert(input.data(), output.data(), pixels);
+                if (state.range(0) == 1) {
+                    stats = InkStats();
+                    accumulateInk(output.data(), PixelFormat::CMYK16, pixels, 0, ink, stats);
+                }
+            }
+            benchmark::DoNotOptimize(stats.maxTac);
+            benchmark::DoNotOptimize(output.data());
+        }
+        setThroughput(state, pixels);
+    }
+
+    // Az renkli çizim (colors farklı renk, 4 Mpx; 0 = gürültü) üzerinde
+    // uniqueColorLimit kapalı/açık. Gürültüde örnekleme cache'i devre dışı bırakır.
+    void BM_UniqueColors(benchmark::State& state) {
+        const size_t pixels = 2048 * 2048;
+        const size_t colors = static_cast<size_t>(state.range(0));
+        ConversionOptions options;
+        if (state.range(1)) options.uniqueColorLimit = UniqueColorCache::kMaxColors;
+
+        ColorConverter converter;
+        if (!initConverter(state, converter, options)) return;
+
+        std::vector<RGB8> input = noise<RGB8>(pixels);
+        if (colors) {
+            // 16 piksellik düz yatay koşular, renkler sabit bir paletten
+            std::vector<RGB8> palette = noise<RGB8>(colors);
+            for (size_t i = 0; i < pixels; ++i) input[i] = palette[(i / 16 * 2654435761u) % colors];
+        }
+        std::vector<CMYK16> output(pixels);
+        for (auto _ : state) {
+            converter.convert(input.data(), output.data(), pixels);
+            benchmark::DoNotOptimize(output.data());
+        }
+        setThroughput(state, pixels);
+    }
+
+    // Tek bir const converter'ı paylaşan benchmark thread'leri (istek işleyen
+    // thread'ler gibi); her thread kendi 256K piksellik isteğini dönüştürür.
+    // Ölçeklenme kilitsiz sıcak yolu gösterir.
+    void BM_SharedConverter(benchmark::State& state) {
+        static ColorConverter shared;
+        static bool ready = false;
+        if (state.thread_index() == 0 && !ready) {
+            ready = shared.initialize(kRgbProfile, kCmykProfile);
+        }
+        const size_t pixels = 256 * 1024;
+        std::vector<RGB8> input = noise<RGB8>(pixels);
+        std::vector<CMYK16> output(pixels);
+        const ColorConverter& converter = shared;
+        for (auto _ : state) {
+            if (!converter.convert(input.data(), output.data(), pixels)) {
+                state.SkipWithError("Dönüşüm başarısız");
+                break;
+            }
+            benchmark::DoNotOptimize(output.data());
+        }
+        setThroughput(state, pixels);
+    }
+
+    // 6000x4000 görüntünün tamamı 1500x1000 ekranda: 0 = ilk (kaba) kare,
+    // 1 = görünüm için gereken seviye. İlk karenin süresi etkileşim gecikmesidir.
+    void BM_SoftProof(benchmark::State& state) {
+        const uint32_t width = 6000, height = 4000;
+        SoftProofer proofer;
+        if (!proofer.initialize(kRgbProfile, kCmykProfile)) {
+            state.SkipWithError("ICC profilleri yüklenemedi");
+            return;
+        }
+        std::vector<RGBA8> image = noise<RGBA8>(static_cast<size_t>(width) * height);
+        proofer.setImage(image.data(), width, height);
+
+        ProofView view;
+        view.source = PixelRect{0, 0, width, height};
+        view.targetWidth = 1500;
+        view.targetHeight = 1000;
+        const unsigned level = state.range(0) == 0 ? proofer.previewLevelFor(view) : proofer.levelFor(view);
+
+        ProofFrame frame;
+        for (auto _ : state) {
+            proofer.render(level, view.source, frame);
+            benchmark::DoNotOptimize(frame.pixels.data());
+        }
+        state.counters["level"] = level;
+        setThroughput(state, frame.pixels.size());
+    }
+
+    // Intent karşılaştırması (1 Mpx, tek thread)
+    void BM_Intent(benchmark::State& state) {
+        const size_t pixels = 1024 * 1024;
+        ConversionOptions options;
+        options.intent = static_cast<cmsUInt32Number>(state.range(0));
+
+        ColorConverter converter;
+        if (!initConverter(state, converter, options)) return;
+
+        std::vector<RGB16> input = noise<RGB16>(pixels);
+        std::vector<CMYK16> output(pixels);
+        for (auto _ : state) {
+            converter.convert(input.data(), output.data(), pixels);
+            benchmark::DoNotOptimize(output.data());
+        }
+        setThroughput(state, pixels);
+    }
+
+    // NOCACHE her zaman eklenir (paylaşılan transform'lar için zorunlu); 0 =
+    // yalnızca NOCACHE, 1 = + HIGHRESPRECALC, 2 = + BLACKPOINTCOMPENSATION,
+    // 3 = kütüphane varsayılanı
+    ConversionOptions flagMode(int64_t mode) {
+        ConversionOptions options;
+        switch (mode) {
+            case 0: options.flags = cmsFLAGS_NOCACHE; break;
+            case 1: options.flags = cmsFLAGS_NOCACHE | cmsFLAGS_HIGHRESPRECALC; break;
+            case 2: options.flags = cmsFLAGS_NOCACHE | cmsFLAGS_BLACKPOINTCOMPENSATION; break;
+            default: break;
+        }
+        return options;
+    }
+
+    const char* flagModeName(int64_t mode) {
+        switch (mode) {
+            case 0: return "NOCACHE";
+            case 1: return "NOCACHE|HIGHRESPRECALC";
+            case 2: return "NOCACHE|BPC";
+            default: return "library";
+        }
+    }
+
+    void BM_Flags(benchmark::State& state) {
+        const size_t pixels = 1024 * 1024;
+        ColorConverter converter;
+        if (!initConverter(state, converter, flagMode(state.range(0)))) return;
+        state.SetLabel(flagModeName(state.range(0)));
+
+        std::vector<RGB16> input = noise<RGB16>(pixels);
+        std::vector<CMYK16> output(pixels);
+        for (auto _ : state) {
+            converter.convert(input.data(), output.data(), pixels);
+            benchmark::DoNotOptimize(output.data());
+        }
+        setThroughput(state, pixels);
+    }
+
+    // 0 = düz lcms2, 1 = fast_float (kuruluysa); etiket gerçekte seçilen motoru gösterir
+    template <typename In, typename Out>
+    void BM_Engine(benchmark::State& state) {
+        const size_t pixels = 1024 * 1024;
+        ConversionOptions options;
+        options.useFastFloat = state.range(0) != 0;
+
+        ColorConverter converter;
+        if (!initConverter(state, converter, options)) return;
+        state.SetLabel(engineName(converter.engine(PixelTraits<In>::format, PixelTraits<Out>::format)));
+
+        std::vector<In> input = noise<In>(pixels);
+        std::vector<Out> output(pixels);
+        for (auto _ : state) {
+            converter.convert(input.data(), output.data(), pixels);
+            benchmark::DoNotOptimize(output.data());
+        }
+        setThroughput(state, pixels);
+    }
+
+    // 1 Mpx, range(0) piksellik çağrılarla: range(1) = 0 çalışma anı formatlı
+    // convert, 1 Converter<In, Out>; range(2) LUT ızgarası (0 = lcms)
+    template <typename In, typename Out>
+    void BM_Typed(benchmark::State& state) {
+        const size_t pixels = 1024 * 1024;
+        const size_t batch = static_cast<size_t>(state.range(0));
+        const bool typed = state.range(1) != 0;
+        ConversionOptions options;
+        options.lutGridPoints = static_cast<unsigned>(state.range(2));
+
+        ColorConverter converter;
+        if (!initConverter(state, converter, options)) return;
+        Converter<In, Out> fixed(converter);
+        state.SetLabel(engineName(fixed.engine()));
+
+        std::vector<In> input = noise<In>(pixels);
+        std::vector<Out> output(pixels);
+        for (auto _ : state) {
+            for (size_t at = 0; at < pixels; at += batch) {
+                if (typed) fixed.convert(input.data() + at, output.data() + at, batch);
+                else converter.convert(input.data() + at, output.data() + at, batch);
+            }
+            benchmark::DoNotOptimize(output.data());
+            benchmark::ClobberMemory();
+        }
+        setThroughput(state, pixels);
+    }
+
+    // 3D LUT: ızgara boyutuna göre hız ve lcms referansına göre ΔE2000
+    template <typename In, typename Out>
+    void BM_Lut(benchmark::State& state) {
+        const size_t pixels = 1024 * 1024;
+        ConversionOptions options;
+        options.lutGridPoints = static_cast<unsigned>(state.range(0));
+
+        ColorConverter converter;
+        if (!initConverter(state, converter, options)) return;
+        state.SetLabel(Lut3D::kernelName());
+
+        std::vector<In> input = noise<In>(pixels);
+        std::vector<Out> output(pixels);
+        for (auto _ : state) {
+            converter.convert(input.data(), output.data(), pixels);
+            benchmark::DoNotOptimize(output.data());
+        }
+        setThroughput(state, pixels);
+
+        LutAccuracy accuracy = converter.lutAccuracy();
+        state.counters["maxDeltaE"] = accuracy.maxDeltaE;
+        state.counters["meanDeltaE"] = accuracy.meanDeltaE;
+    }
+
+    // Transform kurulumu: cache boşken (soğuk) ve doluyken (sıcak)
+    void BM_TransformSetup(benchmark::State& state) {
+        const bool cold = state.range(0) == 0;
+        state.SetLabel(cold ? "cold" : "cached");
+        for (auto _ : state) {
+            if (cold) TransformCache::instance().clear();
+            ColorConverter converter;
+            if (!initConverter(state, converter)) return;
+            benchmark::DoNotOptimize(&converter);
+        }
+    }
+
+    // Kısa ömürlü worker açılışı: süreç içi cache boş, LUT ya yeniden
+    // pişirilir (0) ya da disk cache'ten eşlenir (1)
+    void BM_LutColdStart(benchmark::State& state) {
+        const bool fromDisk = state.range(0) != 0;
+        state.SetLabel(fromDisk ? "disk cache" : "bake");
+
+        ConversionOptions options;
+        options.lutGridPoints = 33;
+        if (fromDisk) {
+            options.lutCacheDirectory = "color_bench_lut_cache";
+            ColorConverter warm;
+            if (!initConverter(state, warm, options)) return;
+        }
+        for (auto _ : state) {
+            TransformCache::instance().clear();
+            ColorConverter converter;
+            if (!initConverter(state, converter, options)) return;
+            benchmark::DoNotOptimize(converter.getLut());
+        }
+        if (fromDisk) {
+            std::error_code ec;
+            std::filesystem::remove_all(options.lutCacheDirectory, ec);
+        }
+    }
+
+    // Yükleme aşaması: stb ile PNG çözme
+    void BM_LoadImage(benchmark::State& state) {
+        int width = 0, height = 0, channels = 0;
+        for (auto _ : state) {
+            uint8_t* data = stbi_load(kTestImage.c_str(), &width, &height, &channels, 3);
+            if (!data) {
+                state.SkipWithError("Test görüntüsü yüklenemedi");
+                return;
+            }
+            benchmark::DoNotOptimize(data);
+            stbi_image_free(data);
+        }
+        setThroughput(state, static_cast<size_t>(width) * height);
+    }
+
+    // ImageReader arka uçları: bellekteki dosyadan 64 satırlık şeritlerle çözme
+    // (0 = stb, 1 = dosya türüne göre en hızlı derlenmiş arka uç)
+    void BM_DecodeRows(benchmark::State& state) {
+        MappedFile file;
+        if (!file.open(kTestImage)) {
+            state.SkipWithError("Test görüntüsü açılamadı");
+            return;
+        }
+        const ImageBackend preferred = state.range(0) ? ImageBackend::Auto : ImageBackend::Stb;
+        std::vector<RGB8> strip;
+        size_t pixels = 0;
+        for (auto _ : state) {
+            std::unique_ptr<ImageReader> reader = ImageReader::create(file.data(), file.size(), preferred);
+            if (!reader) {
+                state.SkipWithError("Test görüntüsü çözülemedi");
+                return;
+            }
+            const ImageInfo& info = reader->info();
+            strip.resize(static_cast<size_t>(info.width) * 64);
+            for (uint32_t row = 0; row < info.height; row += 64) {
+                reader->readRows(strip.data(), 0, std::min<uint32_t>(64, info.height - row));
+                benchmark::DoNotOptimize(strip.data());
+            }
+            pixels = static_cast<size_t>(info.width) * info.height;
+            state.SetLabel(backendName(reader->backend()));
+        }
+        setThroughput(state, pixels);
+    }
+
+    // Uçtan uca: decode + transform + LZW TIFF encode
+    void BM_ConvertImage(benchmark::State& state) {
+        ImageColorConverter converter;
+        if (!converter.initialize(kRgbProfile, kCmykProfile)) {
+            state.SkipWithError("ICC profilleri yüklenemedi");
+            return;
+        }
+        converter.colorConverter().setThreadCount(static_cast<unsigned>(state.range(0)));
+
+        int width = 0, height = 0, channels = 0;
+        stbi_info(kTestImage.c_str(), &width, &height, &channels);
+        const std::string output = "color_bench_output.tiff";
+        for (auto _ : state) {
+            if (!converter.convertImage(kTestImage, output)) {
+                state.SkipWithError("Dönüşüm başarısız");
+                return;
+            }
+        }
+        std::remove(output.c_str());
+
+        // İlk çağrıdan sonra arenanın heap'e gitmemesi beklenir
+        const ScratchStats scratch = converter.scratchArena().stats();
+        state.counters["heap_allocs"] = benchmark::Counter(static_cast<double>(scratch.heapAllocations),
+                                                           benchmark::Counter::kAvgIterations);
+
+        const PipelineStats& stats = converter.lastPipelineStats();
+        state.counters["decode_s"] = stats.decode.busySeconds;
+        state.counters["transform_s"] = stats.transform.busySeconds;
+        state.counters["encode_s"] = stats.encode.busySeconds;
+        setThroughput(state, static_cast<size_t>(width) * height);
+    }
+
+    // Sıkıştırma × yerleşim: range(0) = TiffCompression, range(1) = 0 strip / 1 tile
+    void BM_ConvertImageTiff(benchmark::State& state) {
+        ImageColorConverter converter;
+        if (!converter.initialize(kRgbProfile, kCmykProfile)) {
+            state.SkipWithError("ICC profilleri yüklenemedi");
+            return;
+        }
+        TiffWriteOptions tiff;
+        tiff.compression = static_cast<TiffCompression>(state.range(0));
+        tiff.layout = state.range(1) ? TiffLayout::Tiles : TiffLayout::Strips;
+        tiff.predictor = tiff.compression != TiffCompression::None;
+        converter.setTiffOptions(tiff);
+
+        int width = 0, height = 0, channels = 0;
+        stbi_info(kTestImage.c_str(), &width, &height, &channels);
+        const std::string output = "color_bench_output.tiff";
+        for (auto _ : state) {
+            if (!converter.convertImage(kTestImage, output)) {
+                state.SkipWithError("Dönüşüm başarısız");
+                return;
+            }
+        }
+        std::remove(output.c_str());
+
+        state.counters["encode_s"] = converter.lastPipelineStats().encode.busySeconds;
+        state.counters["parallel"] = tiffCompressionIsParallel(tiff.compression) ? 1 : 0;
+        setThroughput(state, static_cast<size_t>(width) * height);
+    }
+
+    // Piramit çıktının maliyeti: range(0) = 0 düz tile'lı, 1 piramitli (Deflate)
+    void BM_ConvertImagePyramid(benchmark::State& state) {
+        ImageColorConverter converter;
+        if (!converter.initialize(kRgbProfile, kCmykProfile)) {
+            state.SkipWithError("ICC profilleri yüklenemedi");
+            return;
+        }
+        TiffWriteOptions tiff;
+        tiff.compression = TiffCompression::Deflate;
+        tiff.layout = TiffLayout::Tiles;
+        tiff.predictor = true;
+        tiff.pyramid = state.range(0) != 0;
+        converter.setTiffOptions(tiff);
+
+        int width = 0, height = 0, channels = 0;
+        stbi_info(kTestImage.c_str(), &width, &height, &channels);
+        const std::string output = "color_bench_output.tiff";
+        for (auto _ : state) {
+            if (!converter.convertImage(kTestImage, output)) {
+                state.SkipWithError("Dönüşüm başarısız");
+                return;
+            }
+        }
+        std::remove(output.c_str());
+
+        state.counters["encode_s"] = converter.lastPipelineStats().encode.busySeconds;
+        setThroughput(state, static_cast<size_t>(width) * height);
+    }
+
+    // Eşzamansız iş ile doğrudan çağrının farkı. range(0) = 0 convertImage,
+    // 1 ConversionQueue + şerit başına ilerleme; range(1) = şerit bütçesi (KB,
+    // 0 = varsayılan). Küçük bütçe çok şerit, dolayısıyla çok bildirim demektir.
+    void BM_ConversionJob(benchmark::State& state) {
+        const bool async = state.range(0) != 0;
+        const size_t budget = static_cast<size_t>(state.range(1)) * 1024;
+        const std::string output = "color_bench_output.tiff";
+
+        ConversionRequest request;
+        request.inputPath = kTestImage;
+        request.outputPath = output;
+        request.rgbProfilePath = kRgbProfile;
+        request.cmykProfilePath = kCmykProfile;
+        request.memoryBudget = budget;
+
+        ImageColorConverter direct;
+        direct.setVerbose(false);
+        direct.setMemoryBudget(budget);
+        if (!direct.initialize(kRgbProfile, kCmykProfile)) {
+            state.SkipWithError("ICC profilleri yüklenemedi");
+            return;
+        }
+
+        ConversionQueue queue(1);
+        size_t reports = 0;
+        size_t strips = 0;
+        int width = 0, height = 0, channels = 0;
+        stbi_info(kTestImage.c_str(), &width, &height, &channels);
+        for (auto _ : state) {
+            bool ok = false;
+            if (async) {
+                std::shared_ptr<ConversionJob> job =
+                    queue.submit(request, [&](const ConversionProgress&) { ++reports; });
+                ok = job->wait().state == JobState::Succeeded;
+                strips = job->progress().totalStrips;
+            } else {
+                ok = direct.convertImage(kTestImage, output);
+                strips = direct.lastPipelineStats().strips;
+            }
+            if (!ok) {
+                state.SkipWithError("Dönüşüm başarısız");
+                return;
+            }
+        }
+        std::remove(output.c_str());
+
+        state.counters["strips"] = static_cast<double>(strips);
+        state.counters["reports"] = benchmark::Counter(static_cast<double>(reports),
+                                                       benchmark::Counter::kAvgIterations);
+        setThroughput(state, static_cast<size_t>(width) * height);
+    }
+
+    // Tile cache'in maliyeti ve kazancı. range(0) = 0 cache yok, 1 soğuk (her
+    // turda boş cache: özetleme + saklama yükü), 2 sıcak (aynı görüntü tekrar:
+    // dönüşüm ve sıkıştırma atlanır, çözme kalır).
+    void BM_TileCache(benchmark::State& state) {
+        const int mode = static_cast<int>(state.range(0));
+        ImageColorConverter converter;
+        converter.setVerbose(false);
+        if (!converter.initialize(kRgbProfile, kCmykProfile)) {
+            state.SkipWithError("ICC profilleri yüklenemedi");
+            return;
+        }
+        TiffWriteOptions tiff;
+        tiff.compression = TiffCompression::Deflate;
+        tiff.layout = TiffLayout::Tiles;
+        tiff.predictor = true;
+        converter.setTiffOptions(tiff);
+
+        const std::string output = "color_bench_output.tiff";
+        std::shared_ptr<TileCache> cache;
+        if (mode == 2) {
+            cache = std::make_shared<TileCache>();
+            converter.setTileCache(cache);
+            converter.convertImage(kTestImage, output);
+        }
+
+        int width = 0, height = 0, channels = 0;
+        stbi_info(kTestImage.c_str(), &width, &height, &channels);
+        for (auto _ : state) {
+            if (mode == 1) converter.setTileCache(std::make_shared<TileCache>());
+            if (!converter.convertImage(kTestImage, output)) {
+                state.SkipWithError("Dönüşüm başarısız");
+                return;
+            }
+        }
+        std::remove(output.c_str());
+
+        const PipelineStats& stats = converter.lastPipelineStats();
+        state.counters["cached_tiles"] = static_cast<double>(stats.cachedTiles);
+        state.counters["transform_s"] = stats.transform.busySeconds;
+        setThroughput(state, static_cast<size_t>(width) * height);
+    }
+
+    // Kenar uzunlukları: küçük resim, ekran, baskı; 100 Mpx isteğe bağlı
+    void sizeArgs(benchmark::internal::Benchmark* b) {
+        std::vector<int64_t> sides = {128, 1024, 4096};
+        const char* large = std::getenv("COLOR_BENCH_LARGE");
+        if (large && std::string(large) == "1") sides.push_back(10000);
+        for (int64_t side : sides) b->Args({side, 1});
+    }
+
+    void threadArgs(benchmark::internal::Benchmark* b) {
+        const int64_t hardware = ThreadPool::hardwareThreads();
+        for (int64_t threads = 1; threads < hardware; threads *= 2) b->Args({4096, threads});
+        b->Args({4096, hardware});
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_Convert, RGB8, CMYK16)->Apply(sizeArgs)->ArgNames({"side", "threads"})->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Convert, RGB8, CMYK8)->Apply(sizeArgs)->ArgNames({"side", "threads"})->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Convert, RGBA8, CMYK16)->Apply(sizeArgs)->ArgNames({"side", "threads"})->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Convert, RGB16, CMYK16)->Apply(sizeArgs)->ArgNames({"side", "threads"})->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Convert, RGB16, CMYK16)->Name("BM_ConvertThreads")->Apply(threadArgs)->ArgNames({"side", "threads"})->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_Planar)->DenseRange(0, 2)->ArgName("mode")->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Region)->Arg(64)->Arg(256)->Arg(1024)->ArgName("edge")->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_InkStats)->DenseRange(0, 2)->ArgName("mode")->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_UniqueColors)->ArgsProduct({{256, 4096, 0}, {0, 1}})->ArgNames({"colors", "memo"})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SharedConverter)->ThreadRange(1, 8)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_SoftProof)->Arg(0)->Arg(1)->ArgName("final")->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_Intent)->DenseRange(INTENT_PERCEPTUAL, INTENT_ABSOLUTE_COLORIMETRIC)->ArgName("intent")->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Flags)->DenseRange(0, 3)->ArgName("flags")->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Engine, RGB8, CMYK8)->Arg(0)->Arg(1)->ArgName("fast_float")->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Engine, RGB8, CMYK16)->Arg(0)->Arg(1)->ArgName("fast_float")->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Engine, RGB16, CMYK16)->Arg(0)->Arg(1)->ArgName("fast_float")->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Lut, RGB8, CMYK16)->Arg(17)->Arg(33)->Arg(65)->ArgName("grid")->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Lut, RGB16, CMYK16)->Arg(17)->Arg(33)->Arg(65)->ArgName("grid")->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Typed, RGB8, CMYK16)->ArgsProduct({{16, 256, 1 << 20}, {0, 1}, {0, 33}})
+    ->ArgNames({"batch", "typed", "grid"})->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Typed, RGBA8, CMYK8)->ArgsProduct({{16, 256, 1 << 20}, {0, 1}, {0, 33}})
+    ->ArgNames({"batch", "typed", "grid"})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TransformSetup)->Arg(0)->Arg(1)->ArgName("cached")->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_LutColdStart)->Arg(0)->Arg(1)->ArgName("disk")->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LoadImage)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DecodeRows)->Arg(0)->Arg(1)->ArgName("fastest")->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ConvertImage)->Arg(1)->Arg(0)->ArgName("threads")->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_ConvertImageTiff)->ArgsProduct({{0, 1, 2, 3}, {0, 1}})->ArgNames({"codec", "tiles"})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_ConvertImagePyramid)->Arg(0)->Arg(1)->ArgName("pyramid")->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_ConversionJob)->ArgsProduct({{0, 1}, {0, 16}})->ArgNames({"async", "budget_kb"})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_TileCache)->DenseRange(0, 2)->ArgName("cache")->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -1,5 +1,6 @@
 #include "color/ColorConverter.hpp"
 #include "color/ColorTypes.hpp"
+#include "color/Converter.hpp"
 #include <iostream>
 #include <vector>
 
@@ -25,11 +26,8 @@ int main() {
 
     std::vector<CMYK16> cmykPixels(rgbPixels.size());
 
-    // Dönüşümü gerçekleştir
-    if (converter.convertRGBtoCMYK(
-        reinterpret_cast<const uint16_t*>(rgbPixels.data()),
-        reinterpret_cast<uint16_t*>(cmykPixels.data()),
-        rgbPixels.size())) {
+    // Dönüşümü gerçekleştir (formatlar RGB16/CMYK16 tiplerinden seçilir)
+    if (converter.convert(rgbPixels.data(), cmykPixels.data(), rgbPixels.size())) {
         
         std::cout << "Dönüşüm başarılı!" << std::endl;
         
@@ -48,5 +46,41 @@ int main() {
                   << (cmykPixels[0].k * 100.0 / 65535) << "%" << std::endl;
     }
 
+    // 8-bit girdi 16-bit'e genişletilmeden doğrudan dönüştürülebilir
+    std::vector<RGB8> rgb8Pixels = {
+        {255, 255, 255},   // Beyaz
+        {255, 0, 0}        // Kırmızı
+    };
+    std::vector<CMYK8> cmyk8Pixels(rgb8Pixels.size());
+
+    // Format çifti derleme zamanında sabit; transform bir kez seçilir
+    Converter<RGB8, CMYK8> rgb8ToCmyk8(converter);
+    if (rgb8ToCmyk8.convert(rgb8Pixels.data(), cmyk8Pixels.data(), rgb8Pixels.size())) {
+        std::cout << "Kırmızı CMYK değerleri (8-bit): "
+                  << int(cmyk8Pixels[1].c) << ", "
+                  << int(cmyk8Pixels[1].m) << ", "
+                  << int(cmyk8Pixels[1].y) << ", "
+                  << int(cmyk8Pixels[1].k) << std::endl;
+    }
+
+    // Önceden hesaplanmış 33^3 LUT; ilk çalıştırmada oluşturulup cache dizinine
+    // yazılır, sonraki çalıştırmalarda dosyadan eşlenir
+    ConversionOptions lutOptions;
+    lutOptions.lutGridPoints = 33;
+    lutOptions.lutCacheDirectory = "../resources/icc_profiles/cache";
+
+    ColorConverter lutConverter;
+    if (lutConverter.initialize(rgbProfile, cmykProfile, lutOptions)) {
+        std::vector<CMYK16> lutPixels(rgbPixels.size());
+        lutConverter.convert(rgbPixels.data(), lutPixels.data(), rgbPixels.size());
+
+        LutAccuracy accuracy = lutConverter.lutAccuracy();
+        std::cout << "LUT (" << Lut3D::kernelName() << ") kırmızı: "
+                  << lutPixels[1].c << ", " << lutPixels[1].m << ", "
+                  << lutPixels[1].y << ", " << lutPixels[1].k
+                  << " | maks. ΔE2000: " << accuracy.maxDeltaE
+                  << ", ortalama: " << accuracy.meanDeltaE << std::endl;
+    }
+
     return 0;
 } 
\ No newline at end of file
@@ -1,150 +1,179 @@
+#include "color/BatchConverter.hpp"
+#include "color/ImageColorConverter.hpp"
+#include <cerrno>
+#include <cstdlib>
+#include <filesystem>
 #include <iostream>
-#include <vector>
 #include <string>
-#include "lcms2.h"
-#include <tiffio.h>
-
-// stb_image kütüphanelerini dahil et
-#define STB_IMAGE_IMPLEMENTATION
-#include "/home/emre/denemeler/tauri-test/include/stb_image.h"
-#define STB_IMAGE_WRITE_IMPLEMENTATION
-#include "/home/emre/denemeler/tauri-test/include/stb_image_write.h"
-
-class ImageColorConverter {
-public:
-    bool initialize(const std::string& rgbProfilePath, const std::string& cmykProfilePath) {
-        // ICC profillerini yükle
-        hInProfile = cmsOpenProfileFromFile(rgbProfilePath.c_str(), "r");
-        hOutProfile = cmsOpenProfileFromFile(cmykProfilePath.c_str(), "r");
-        
-        if (!hInProfile || !hOutProfile) {
-            cleanup();
-            return false;
-        }
-
-        // Dönüşüm için transform oluştur
-        hTransform = cmsCreateTransform(
-            hInProfile,
-            TYPE_RGB_16,
-            hOutProfile,
-            TYPE_CMYK_16,
-            INTENT_PERCEPTUAL,
-            0);
-
-        if (!hTransform) {
-            cleanup();
-            return false;
-        }
+#include <system_error>
+#include <vector>
 
-        return true;
+namespace {
+    // ICC profil yolları - projenizin resources klasörüne göre ayarlayın
+    std::string rgbProfile = "../resources/icc_profiles/sRGB.icc";
+    std::string cmykProfile = "../resources/icc_profiles/output_CMYK.icc";
+
+    void printUsage(const char* program) {
+        std::cout << "Kullanım: " << program << " [seçenekler] <girdi dosyası veya dizini>...\n"
+                  << "  Argümansız çalıştırılırsa örnek görüntüyü dönüştürür.\n"
+                  << "  -o, --output <dizin>   Çıktı dizini (varsayılan: girdinin yanı)\n"
+                  << "  -j, --jobs <n>         Aynı anda işlenecek dosya (0 = tüm çekirdekler)\n"
+                  << "  -m, --memory <MB>      Dolaşımdaki dosyalar için bellek bütçesi\n"
+                  << "  --rgb <icc>            RGB profili\n"
+                  << "  --cmyk <icc>           CMYK profili\n"
+                  << "  --lut <n>              n^3 3D LUT ile dönüştür (ör. 33)" << std::endl;
     }
 
-    bool convertImage(const std::string& inputPath, const std::string& outputPath) {
-        int width, height, channels;
-        std::cout << "Input path: " << inputPath << std::endl;
-        std::cout << "Output path: " << outputPath << std::endl;
-        // Resmi yükle
-        uint8_t* inputData = stbi_load(inputPath.c_str(), &width, &height, &channels, 3);
-        if (!inputData) {
-            std::cerr << "Resim yüklenemedi: " << inputPath << std::endl;
-            return false;
-        }
-
-        // RGB 8-bit'ten RGB 16-bit'e dönüştür
-        std::vector<uint16_t> rgb16Data(width * height * 3);
-        for (int i = 0; i < width * height * 3; ++i) {
-            rgb16Data[i] = static_cast<uint16_t>(inputData[i] * 257); // 8-bit to 16-bit
+    int convertBatch(int argc, char** argv) {
+        std::string outputDirectory;
+        unsigned jobs = 0;
+        size_t memoryMB = 0;
+        ConversionOptions options;
+        std::vector<std::string> inputs;
+
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    std::cerr << "Eksik değer: " << arg << std::endl;
+                    std::exit(2);
+                }
+                return argv[++i];
+            };
+            // Geçersiz sayı ("--jobs abc") istisna yerine kullanım hatası olur
+            auto number = [&]() -> unsigned long {
+                const std::string text = value();
+                char* end = nullptr;
+                errno = 0;
+                const unsigned long parsed = std::strtoul(text.c_str(), &end, 10);
+                if (text.empty() || *end != '\0' || errno == ERANGE || text[0] == '-') {
+                    std::cerr << "Geçersiz sayı: " << arg << " " << text << std::endl;
+                    printUsage(argv[0]);
+                    std::exit(2);
+                }
+                return parsed;
+            };
+            if (arg == "-h" || arg == "--help") {
+                printUsage(argv[0]);
+                return 0;
+            } else if (arg == "-o" || arg == "--output") {
+                outputDirectory = value();
+            } else if (arg == "-j" || arg == "--jobs") {
+                jobs = static_cast<unsigned>(number());
+            } else if (arg == "-m" || arg == "--memory") {
+                memoryMB = number();
+            } else if (arg == "--rgb") {
+                rgbProfile = value();
+            } else if (arg == "--cmyk") {
+                cmykProfile = value();
+            } else if (arg == "--lut") {
+                options.lutGridPoints = static_cast<unsigned>(number());
+            } else {
+                inputs.push_back(arg);
+            }
         }
 
-        // CMYK çıktı verisi için buffer (16-bit)
-        std::vector<uint16_t> cmykData(width * height * 4);
-
-        // Renk dönüşümünü gerçekleştir
-        cmsDoTransform(hTransform, rgb16Data.data(), cmykData.data(), width * height);
-
-        // TIFF olarak kaydet (16-bit CMYK)
-        TIFF* tif = TIFFOpen(outputPath.c_str(), "w");
-        if (!tif) {
-            std::cerr << "TIFF dosyası oluşturulamadı" << std::endl;
-            stbi_image_free(inputData);
-            return false;
-        }
+        std::error_code ec;
+        if (!outputDirectory.empty()) std::filesystem::create_directories(outputDirectory, ec);
 
-        // TIFF parametrelerini ayarla
-        TIFFSetField(tif, TIFFTAG_IMAGEWIDTH, width);
-        TIFFSetField(tif, TIFFTAG_IMAGELENGTH, height);
-        TIFFSetField(tif, TIFFTAG_SAMPLESPERPIXEL, 4); // CMYK
-        TIFFSetField(tif, TIFFTAG_BITSPERSAMPLE, 16);  // 16-bit
-        TIFFSetField(tif, TIFFTAG_ORIENTATION, ORIENTATION_TOPLEFT);
-        TIFFSetField(tif, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
-        TIFFSetField(tif, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_SEPARATED); // CMYK
-        TIFFSetField(tif, TIFFTAG_COMPRESSION, COMPRESSION_LZW);       // LZW sıkıştırma
-
-        // ICC profilini gömme
-        cmsUInt32Number profileSize;
-        cmsSaveProfileToMem(hOutProfile, NULL, &profileSize); // Profil boyutunu al
-        void* profileData = malloc(profileSize);
-        cmsSaveProfileToMem(hOutProfile, profileData, &profileSize);
-        TIFFSetField(tif, TIFFTAG_ICCPROFILE, profileSize, profileData);
-
-        // CMYK verilerini yaz
-        for (int row = 0; row < height; row++) {
-            if (TIFFWriteScanline(tif, &cmykData[row * width * 4], row, 0) < 0) {
-                std::cerr << "TIFF yazma hatası" << std::endl;
-                TIFFClose(tif);
-                free(profileData);
-                stbi_image_free(inputData);
-                return false;
+        std::vector<BatchItem> items;
+        for (const std::string& input : inputs) {
+            if (std::filesystem::is_directory(input, ec)) {
+                std::vector<BatchItem> found = BatchConverter::fromDirectory(input, outputDirectory);
+                items.insert(items.end(), found.begin(), found.end());
+            } else {
+                items.push_back(BatchConverter::itemFor(input, outputDirectory));
             }
         }
+        if (items.empty()) {
+            std::cerr << "Dönüştürülecek görüntü bulunamadı" << std::endl;
+            return 1;
+        }
 
-        TIFFClose(tif);
-        free(profileData);
-        stbi_image_free(inputData);
-        return true;
-    }
+        BatchConverter batch;
+        if (!batch.initialize(rgbProfile, cmykProfile, options)) {
+            std::cerr << "Converter başlatılamadı!" << std::endl;
+            return 1;
+        }
+        batch.setParallelFiles(jobs);
+        if (memoryMB) batch.setMemoryBudget(memoryMB * 1024 * 1024);
+
+        // Sonuçlar dosyalar bittikçe yazılır
+        BatchSummary summary = batch.run(items, [&](const BatchResult& result) {
+            if (result.success) {
+                std::cout << "[" << result.index + 1 << "/" << items.size() << "] "
+                          << result.inputPath << " -> " << result.outputPath
+                          << " (" << result.seconds << " s)" << std::endl;
+            } else {
+                std::cerr << "[" << result.index + 1 << "/" << items.size() << "] HATA "
+                          << result.inputPath << ": " << result.error << std::endl;
+            }
+        });
 
-    ~ImageColorConverter() {
-        cleanup();
+        std::cout << summary.succeeded << " başarılı, " << summary.failed << " hatalı, "
+                  << summary.wallSeconds << " s" << std::endl;
+        return summary.failed ? 1 : 0;
     }
+}
 
-private:
-    cmsHPROFILE hInProfile = nullptr;
-    cmsHPROFILE hOutProfile = nullptr;
-    cmsHTRANSFORM hTransform = nullptr;
-
-    void cleanup() {
-        if (hTransform) cmsDeleteTransform(hTransform);
-        if (hInProfile) cmsCloseProfile(hInProfile);
-        if (hOutProfile) cmsCloseProfile(hOutProfile);
-        hTransform = nullptr;
-        hInProfile = nullptr;
-        hOutProfile = nullptr;
-    }
-};
+int main(int argc, char** argv) {
+    if (argc > 1) return convertBatch(argc, argv);
 
-int main() {
     ImageColorConverter converter;
-    
-    // ICC profil yolları
-    std::string rgbProfile = "/home/emre/denemeler/tauri-test/resources/icc_profiles/sRGB.icc";
-    std::string cmykProfile = "/home/emre/denemeler/tauri-test/resources/icc_profiles/output_CMYK.icc";
-    
+
+    // Aşama sayaçları ve Chrome/Perfetto trace kaydı (profil açılışı dahil)
+    converter.colorConverter().instrumentation().setTracing(true);
+
     if (!converter.initialize(rgbProfile, cmykProfile)) {
         std::cerr << "Converter başlatılamadı!" << std::endl;
         return 1;
     }
 
+    // Tüm çekirdekleri kullan, şerit belleğini 64 MB ile sınırla
+    converter.colorConverter().setThreadCount(0);
+    converter.setMemoryBudget(64u * 1024 * 1024);
+
+    // Baskı öncesi kontrol: %300 toplam mürekkep sınırı, dönüşümle aynı geçişte
+    InkOptions ink;
+    ink.tacLimit = 300.0;
+    converter.setInkAnalysis(true, ink);
+
     // Dönüşümü gerçekleştir
-    std::string inputImage = "/home/emre/denemeler/tauri-test/resources/images/test_9000.png";  // veya .jpg
-    std::string outputImage = "/home/emre/denemeler/tauri-test/resources/images/output_test2.tiff";
+    std::string inputImage = "../resources/images/test.png";  // veya .jpg
+    std::string outputImage = "../resources/images/output_test2.tiff";
     
     if (converter.convertImage(inputImage, outputImage)) {
         std::cout << "Dönüşüm başarılı! Dosya kaydedildi: " << outputImage << std::endl;
+
+        // Aşama süreleri: darboğazı görmek için
+        const PipelineStats& stats = converter.lastPipelineStats();
+        std::cout << "Toplam: " << stats.wallSeconds << " s, " << stats.strips << " şerit" << std::endl;
+        std::cout << "  decode:    meşgul " << stats.decode.busySeconds << " s, boşta " << stats.decode.idleSeconds << " s" << std::endl;
+        std::cout << "  transform: meşgul " << stats.transform.busySeconds << " s, boşta " << stats.transform.idleSeconds << " s" << std::endl;
+        std::cout << "  encode:    meşgul " << stats.encode.busySeconds << " s, boşta " << stats.encode.idleSeconds << " s" << std::endl;
+        std::cout << "Darboğaz: " << stats.bottleneck() << std::endl;
+
+        const InkStats& inkStats = converter.lastInkStats();
+        std::cout << "Mürekkep: ortalama TAC %" << inkStats.averageTac()
+                  << ", en yüksek %" << inkStats.maxTacPercent() << " (piksel " << inkStats.maxTacPixel << ")"
+                  << ", %300 üstü " << inkStats.overLimitPixels << " piksel" << std::endl;
+
+        Instrumentation& instr = converter.colorConverter().instrumentation();
+        InstrumentationStats counters = instr.snapshot();
+        for (size_t i = 0; i < kStageCount; ++i) {
+            const StageStats& stage = counters.stages[i];
+            std::cout << "  " << Instrumentation::stageName(static_cast<Stage>(i)) << ": "
+                      << stage.calls << " çağrı, " << stage.totalSeconds() << " s" << std::endl;
+        }
+        std::cout << "Piksel: " << counters.pixels << ", TIFF bayt: " << counters.tiffBytes
+                  << ", ayırma: " << counters.allocations << " (" << counters.allocatedBytes << " bayt)" << std::endl;
+        if (instr.writeChromeTrace("color_trace.json")) {
+            std::cout << "Trace kaydedildi: color_trace.json (ui.perfetto.dev ile açın)" << std::endl;
+        }
     } else {
         std::cerr << "Dönüşüm sırasında hata oluştu!" << std::endl;
         return 1;
     }
 
     return 0;
-} 
\ No newline at end of file
+}
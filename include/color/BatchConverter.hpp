@@ -0,0 +1,81 @@
+#ifndef BATCH_CONVERTER_HPP
+#define BATCH_CONVERTER_HPP
+
+#include "color/ColorConverter.hpp"
+#include "color/ImageColorConverter.hpp"
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+struct BatchItem {
+    std::string inputPath;
+    std::string outputPath;
+};
+
+// Tek bir dosyanın sonucu; geri çağrıya dosya bittiği anda verilir
+struct BatchResult {
+    size_t index = 0;           // girdi listesindeki sırası
+    std::string inputPath;
+    std::string outputPath;
+    bool success = false;
+    std::string error;
+    double seconds = 0;
+    PipelineStats stats;
+};
+
+struct BatchSummary {
+    size_t succeeded = 0;
+    size_t failed = 0;
+    double wallSeconds = 0;
+};
+
+// Çok sayıda görüntüyü aynı profil çiftiyle dönüştürür. Profiller ve
+// transform'lar TransformCache üzerinden bir kez oluşturulur; her worker
+// thread'in kendi ImageColorConverter'ı olur ve dosyaları sırayla çeker.
+//
+// Aynı anda işlenen dosyaların tahmini bellek toplamı (çözülmüş 8-bit görüntü
+// + şerit buffer'ları) setMemoryBudget ile sınırlanır; bütçeyi tek başına
+// aşan bir dosya yalnızca başka dosya işlenmiyorken başlar.
+class BatchConverter {
+public:
+    using ResultCallback = std::function<void(const BatchResult&)>;
+
+    BatchConverter();
+
+    bool initialize(const std::string& rgbProfilePath,
+                    const std::string& cmykProfilePath,
+                    const ConversionOptions& options = ConversionOptions());
+
+    // Aynı anda işlenecek dosya sayısı; 0 = donanım thread sayısı
+    void setParallelFiles(unsigned count);
+    unsigned getParallelFiles() const { return parallelFiles; }
+
+    // Dolaşımdaki dosyaların toplam bellek üst sınırı (bayt)
+    void setMemoryBudget(size_t bytes);
+    size_t getMemoryBudget() const { return memoryBudget; }
+
+    // Geri çağrı tek seferde bir thread'den çağrılır (kilit altında);
+    // uzun iş yapmamalıdır. outputPath'i önceki bir öğeyle aynı olan öğe
+    // dönüştürülmez, hata ile başarısız sayılır.
+    BatchSummary run(const std::vector<BatchItem>& items, const ResultCallback& onResult);
+
+    // Dizindeki desteklenen görüntüleri (png, jpg, bmp, tga, gif, psd, pnm)
+    // ada göre sıralı listeler; çıktı outputDirectory/<ad>.tiff olur. Aynı
+    // adlı birden çok görüntü varsa (logo.png, logo.jpg) bunların çıktısı
+    // <ad>_<uzantı>.tiff olur (logo_png.tiff, logo_jpg.tiff).
+    static std::vector<BatchItem> fromDirectory(const std::string& inputDirectory,
+                                                const std::string& outputDirectory);
+
+    // Girdinin yanına aynı adla .tiff yazar (outputDirectory boşsa)
+    static BatchItem itemFor(const std::string& inputPath, const std::string& outputDirectory);
+
+private:
+    // Worker'lar bundan başlatılır: profiller, transform ve pişmiş LUT paylaşılır
+    ColorConverter prototype;
+    bool initialized;
+    unsigned parallelFiles;
+    size_t memoryBudget;
+};
+
+#endif // BATCH_CONVERTER_HPP
@@ -2,25 +2,225 @@
 #define COLOR_CONVERTER_HPP
 
 #include <lcms2.h>
+#include <atomic>
+#include "color/ColorTypes.hpp"
+#include "color/InkStatistics.hpp"
+#include "color/Instrumentation.hpp"
+#include "color/Lut3D.hpp"
+#include "color/TransformCache.hpp"
 #include <string>
 #include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <utility>
 
+class ThreadPool;
+
+template <typename In, typename Out> class Converter;
+
+// Transform oluşturma ayarları
+struct ConversionOptions {
+    cmsUInt32Number intent = INTENT_PERCEPTUAL;
+    cmsUInt32Number flags =
+        cmsFLAGS_BLACKPOINTCOMPENSATION |
+        cmsFLAGS_HIGHRESPRECALC |  // Yüksek hassasiyet için
+        cmsFLAGS_NOCACHE;          // Paylaşılan 1 piksellik cache yok; verilmese de initialize ekler
+    bool useFastFloat = true;      // lcms2_fast_float eklentisi kuruluysa kullan
+    // 0 = kapalı; aksi halde RGB -> CMYK dönüşümleri bu ızgarada (ör. 33, 65)
+    // önceden hesaplanmış 3D LUT ile yapılır. Hız/doğruluk için bkz. lutAccuracy.
+    unsigned lutGridPoints = 0;
+    // Boş değilse pişirilmiş LUT bu dizinde saklanır ve sonraki açılışlarda
+    // bellek eşlemesiyle yüklenir (ör. "resources/icc_profiles/cache")
+    std::string lutCacheDirectory;
+    // 0 = kapalı; aksi halde az renkli girdi (örneklemle sezilir) bu sayıya
+    // kadar farklı rengi tek tek dönüştürüp sonuçları piksellere dağıtır.
+    // Sınır aşılırsa kalan pikseller doğrudan dönüştürülür. En fazla 65535.
+    size_t uniqueColorLimit = 0;
+};
+
+// Profiller ve transform süreç genelindeki TransformCache'ten alınır;
+// aynı profil çiftiyle oluşturulan converter'lar tek bir transform'u paylaşır.
+//
+// Eşzamanlılık modeli: initialize ve set* ayarları converter paylaşılmadan
+// önce tek thread'den yapılır. Sonrasında const dönüşüm metotları (convert*,
+// engine, lutAccuracy) istenen sayıda thread'den aynı anda, kilitsiz
+// çağrılabilir: options.flags ne olursa olsun transform'lar cmsFLAGS_NOCACHE
+// ile oluşturulduğundan
+// thread'ler arasında değişen durum yoktur, format çifti başına transform ilk
+// kullanımda bir kez kurulup atomik olarak yayınlanır, LUT salt okunurdur.
+// setThreadCount ile açılan havuz da eşzamanlı çağrılar arasında paylaşılır.
+//
+// Kopyalanamaz (havuz ve transform tablosu tek sahiplidir); taşınabilir.
+// Taşıma eşzamanlı kullanım sürerken yapılmamalıdır; taşınan nesne
+// başlatılmamış bir converter gibi davranır.
 class ColorConverter {
 public:
     ColorConverter();
     ~ColorConverter();
 
+    ColorConverter(const ColorConverter&) = delete;
+    ColorConverter& operator=(const ColorConverter&) = delete;
+
+    ColorConverter(ColorConverter&& other);
+    ColorConverter& operator=(ColorConverter&& other);
+
     bool initialize(const std::string& rgbProfilePath, 
                    const std::string& cmykProfilePath);
+
+    bool initialize(const std::string& rgbProfilePath,
+                    const std::string& cmykProfilePath,
+                    const ConversionOptions& options);
+
+    // Önceden açılmış profillerle (TransformCache::openProfile veya
+    // openProfileFromMemory); dosya sistemine hiç gidilmez
+    bool initialize(const CachedProfile& rgbProfile,
+                    const CachedProfile& cmykProfile,
+                    const ConversionOptions& options = ConversionOptions());
+
+    // Başlatılmış bir converter'ın profilleri, ayarları ve pişmiş LUT'u ile;
+    // LUT tekrar hesaplanmaz, paylaşılır. Thread ayarları kopyalanmaz.
+    bool initialize(const ColorConverter& source);
+
+    const ConversionOptions& getOptions() const { return options; }
     
     bool convertRGBtoCMYK(const uint16_t* rgbData, 
                          uint16_t* cmykData, 
-                         size_t pixelCount);
+                         size_t pixelCount) const;
+
+    // Satır aralıklı (ör. dolgulu framebuffer) RGB16 görüntünün bir bölgesi;
+    // bkz. convert(..., region)
+    bool convertRGBtoCMYK(const uint16_t* rgbData, size_t rgbStride,
+                          uint16_t* cmykData, size_t cmykStride,
+                          size_t width, size_t height, const PixelRect& region) const;
+
+    // Piksel formatları çağrı başına seçilir (ör. RGB8 -> CMYK16). Her format
+    // çifti için transform ilk kullanımda TransformCache'ten alınır, böylece
+    // 8-bit girdi 16-bit'e genişletilmeden doğrudan dönüştürülür.
+    bool convert(const void* input, PixelFormat inputFormat,
+                 void* output, PixelFormat outputFormat,
+                 size_t pixelCount) const;
+
+    // Dönüşümle aynı geçişte çıktının mürekkep istatistiklerini (TAC, kanal
+    // kapsamaları, histogramlar) hesaplar ve istenirse TAC sınırını uygular;
+    // çıktı tekrar okunmaz. Çıktı CMYK8 veya CMYK16; stats sıfırlanıp doldurulur.
+    bool convert(const void* input, PixelFormat inputFormat,
+                 void* output, PixelFormat outputFormat,
+                 size_t pixelCount, const InkOptions& ink, InkStats& stats) const;
+
+    // width x height görüntü, satırlar inputStride / outputStride bayt arayla
+    // (0 = sıkışık). Yalnızca region içindeki pikseller dönüştürülür ve
+    // çıktıda aynı konuma yazılır; bölge dışına dokunulmaz. Ara kopya yoktur.
+    bool convert(const void* input, PixelFormat inputFormat, size_t inputStride,
+                 void* output, PixelFormat outputFormat, size_t outputStride,
+                 size_t width, size_t height, const PixelRect& region) const;
+
+    bool convert(const void* input, PixelFormat inputFormat, size_t inputStride,
+                 void* output, PixelFormat outputFormat, size_t outputStride,
+                 size_t width, size_t height) const;
+
+    // Düzlemsel çıktı: C, M, Y, K ayrı buffer'lara doğrudan yazılır (her biri
+    // pixelCount eleman, CMYK8 için uint8_t, CMYK16 için uint16_t).
+    // Düzlemler tek buffer'da eşit aralıklıysa lcms ara kopya yapmadan yazar.
+    bool convertPlanar(const void* input, PixelFormat inputFormat,
+                       const CMYKPlanes& output, PixelFormat outputFormat,
+                       size_t pixelCount) const;
+
+    // Tipli arayüz: convert(rgb8Pixels, cmyk16Pixels, count). Format
+    // seçimi her çağrıda yapılır; sıcak döngüler için bkz. Converter<In, Out>.
+    template <typename In, typename Out>
+    bool convert(const In* input, Out* output, size_t pixelCount) const {
+        return convert(input, PixelTraits<In>::format,
+                       output, PixelTraits<Out>::format,
+                       pixelCount);
+    }
+
+    template <typename In, typename Out>
+    bool convert(const In* input, Out* output, size_t pixelCount,
+                 const InkOptions& ink, InkStats& stats) const {
+        return convert(input, PixelTraits<In>::format,
+                       output, PixelTraits<Out>::format,
+                       pixelCount, ink, stats);
+    }
+
+    template <typename In, typename Out>
+    bool convert(const In* input, size_t inputStride, Out* output, size_t outputStride,
+                 size_t width, size_t height, const PixelRect& region) const {
+        return convert(input, PixelTraits<In>::format, inputStride,
+                       output, PixelTraits<Out>::format, outputStride,
+                       width, height, region);
+    }
+
+    // Paralel dönüşüm için kullanılacak thread sayısı (çağıran thread dahil).
+    // 1 = seri (varsayılan), 0 = donanım thread sayısı.
+    void setThreadCount(unsigned threadCount);
+    unsigned getThreadCount() const { return threadCount; }
+
+    // Paralel modda her görevin işleyeceği piksel sayısı
+    void setChunkPixels(size_t pixels);
+    size_t getChunkPixels() const { return chunkPixels; }
+
+    // Bu format çiftinin transform'unu hangi motorun çalıştırdığı
+    // (gerekirse transform'u oluşturur)
+    TransformEngine engine(PixelFormat inputFormat, PixelFormat outputFormat) const;
+
+    // LUT etkinse doğruluğu (lcms referansına göre maksimum/ortalama ΔE2000)
+    LutAccuracy lutAccuracy(unsigned samplesPerAxis = 32) const;
+    const Lut3D* getLut() const { return lut.get(); }
+
+    // TIFF'e gömmek için çıktı (CMYK) profili
+    cmsHPROFILE getOutputProfile() const { return outProfile.get(); }
+
+    // Çıktı profilinin ICC baytları; profil açılırken bir kez okunur ve tüm
+    // converter'lar/yazıcılar arasında salt okunur paylaşılır
+    const ProfileData& getOutputProfileData() const { return outProfile.data; }
+
+    const CachedProfile& getInputCachedProfile() const { return inProfile; }
+    const CachedProfile& getOutputCachedProfile() const { return outProfile; }
+
+    // Aşama süreleri ve sayaçlar; varsayılan kapalı, instrumentation().setEnabled(true) ile açılır
+    Instrumentation& instrumentation() const { return *instr; }
+    InstrumentationStats instrumentationStats() const { return instr->snapshot(); }
 
 private:
-    cmsHPROFILE hInProfile;
-    cmsHPROFILE hOutProfile;
-    cmsHTRANSFORM hTransform;
+    // Bağlanırken prepare'i, dönüşümde havuzu ve ölçümleri kullanır
+    template <typename In, typename Out> friend class Converter;
+
+    static constexpr size_t kFormatCount = static_cast<size_t>(PixelFormat::CMYK16) + 1;
+
+    void swap(ColorConverter& other);
+    void clearTransforms();
+    cmsHTRANSFORM transformFor(PixelFormat inputFormat, PixelFormat outputFormat,
+                               bool planarOutput = false) const;
+    bool initializeLut();
+    // Bitişik dönüşüm; ink verilmişse istatistikler aynı geçişte toplanır
+    bool convertContiguous(const void* input, PixelFormat inputFormat,
+                           void* output, PixelFormat outputFormat, size_t pixelCount,
+                           const InkOptions* ink, InkStats* stats) const;
+    // Hazır olma ve format kontrolü; format çifti için LUT'u veya transform'u seçer
+    bool prepare(PixelFormat inputFormat, PixelFormat outputFormat, bool planarOutput,
+                 const Lut3D*& table, cmsHTRANSFORM& transform) const;
+
+    ConversionOptions options;
+    // İşaretçi arkasında: sayaçlar converter taşınınca onunla gider
+    std::unique_ptr<Instrumentation> instr;
+
+    // TransformCache'ten paylaşılan profiller ve format çifti başına transform'lar
+    CachedProfile inProfile;
+    CachedProfile outProfile;
+    // RGB16 -> CMYK16 dahil tüm transform'lar ilk kullanımda oluşturulur.
+    // Sahiplik map'tedir (transformMutex altında); sıcak yol yalnızca
+    // publishedTransforms'taki atomik işaretçiyi okur.
+    mutable std::mutex transformMutex;
+    mutable std::map<std::tuple<PixelFormat, PixelFormat, bool>, std::shared_ptr<void>> transforms;
+    mutable std::atomic<cmsHTRANSFORM> publishedTransforms[kFormatCount][kFormatCount][2];
+    bool ready;
+    std::shared_ptr<const Lut3D> lut;
+
+    unsigned threadCount;
+    size_t chunkPixels;
+    std::unique_ptr<ThreadPool> pool;
 };
 
-#endif // COLOR_CONVERTER_HPP 
\ No newline at end of file
+#endif // COLOR_CONVERTER_HPP 
@@ -1,14 +1,111 @@
 #ifndef COLOR_TYPES_HPP
 #define COLOR_TYPES_HPP
 
+#include <cstddef>
 #include <cstdint>
 
+struct RGB8 {
+    uint8_t r, g, b;
+};
+
+struct RGBA8 {
+    uint8_t r, g, b, a;
+};
+
 struct RGB16 {
     uint16_t r, g, b;
 };
 
+struct CMYK8 {
+    uint8_t c, m, y, k;
+};
+
 struct CMYK16 {
     uint16_t c, m, y, k;
 };
 
-#endif // COLOR_TYPES_HPP 
\ No newline at end of file
+// Görüntü içinde dikdörtgen bölge (piksel cinsinden)
+struct PixelRect {
+    size_t x = 0;
+    size_t y = 0;
+    size_t width = 0;
+    size_t height = 0;
+};
+
+// Düzlemsel (planar) CMYK: her kanal ayrı, bitişik bir buffer. Eleman tipi
+// çıktı formatından gelir (CMYK8 -> uint8_t, CMYK16 -> uint16_t).
+struct CMYKPlanes {
+    void* planes[4];   // C, M, Y, K
+};
+
+// ColorConverter'ın çağrı başına kabul ettiği piksel düzenleri
+enum class PixelFormat {
+    RGB8,
+    RGBA8,   // alfa kanalı dönüşümde yok sayılır
+    RGB16,
+    CMYK8,
+    CMYK16
+};
+
+constexpr size_t bytesPerPixel(PixelFormat format) {
+    switch (format) {
+        case PixelFormat::RGB8:   return 3;
+        case PixelFormat::RGBA8:  return 4;
+        case PixelFormat::RGB16:  return 6;
+        case PixelFormat::CMYK8:  return 4;
+        case PixelFormat::CMYK16: return 8;
+    }
+    return 0;
+}
+
+// Piksel struct'ından formata derleme zamanı eşlemesi. Sample kanal tipi,
+// channels bellekteki kanal sayısı (alfa dahil), colorChannels dönüşüme
+// giren kanal sayısıdır; maxValue kanalın tam ölçek değeridir.
+template <typename Pixel> struct PixelTraits;
+
+template <> struct PixelTraits<RGB8> {
+    static constexpr PixelFormat format = PixelFormat::RGB8;
+    using Sample = uint8_t;
+    static constexpr size_t channels = 3;
+    static constexpr size_t colorChannels = 3;
+    static constexpr bool rgb = true;
+    static constexpr unsigned maxValue = 255;
+};
+
+template <> struct PixelTraits<RGBA8> {
+    static constexpr PixelFormat format = PixelFormat::RGBA8;
+    using Sample = uint8_t;
+    static constexpr size_t channels = 4;
+    static constexpr size_t colorChannels = 3;
+    static constexpr bool rgb = true;
+    static constexpr unsigned maxValue = 255;
+};
+
+template <> struct PixelTraits<RGB16> {
+    static constexpr PixelFormat format = PixelFormat::RGB16;
+    using Sample = uint16_t;
+    static constexpr size_t channels = 3;
+    static constexpr size_t colorChannels = 3;
+    static constexpr bool rgb = true;
+    static constexpr unsigned maxValue = 65535;
+};
+
+template <> struct PixelTraits<CMYK8> {
+    static constexpr PixelFormat format = PixelFormat::CMYK8;
+    using Sample = uint8_t;
+    static constexpr size_t channels = 4;
+    static constexpr size_t colorChannels = 4;
+    static constexpr bool rgb = false;
+    static constexpr unsigned maxValue = 255;
+};
+
+template <> struct PixelTraits<CMYK16> {
+    static constexpr PixelFormat format = PixelFormat::CMYK16;
+    using Sample = uint16_t;
+    static constexpr size_t channels = 4;
+    static constexpr size_t colorChannels = 4;
+    static constexpr bool rgb = false;
+    static constexpr unsigned maxValue = 65535;
+};
+
+#endif // COLOR_TYPES_HPP
@@ -0,0 +1,139 @@
+#ifndef CONVERSION_JOB_HPP
+#define CONVERSION_JOB_HPP
+
+#include "color/ColorConverter.hpp"
+#include "color/ImageColorConverter.hpp"
+#include "color/ThreadPool.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+enum class JobState {
+    Queued,
+    Running,
+    Succeeded,
+    Failed,
+    Cancelled
+};
+
+const char* jobStateName(JobState state);
+
+// Görüntü dosyası işi: ImageColorConverter::convertImage'in parametreleri
+struct ConversionRequest {
+    std::string inputPath;
+    std::string outputPath;
+    std::string rgbProfilePath;
+    std::string cmykProfilePath;
+    ConversionOptions options;
+    TiffWriteOptions tiff;
+    unsigned threads = 1;        // iş başına dönüşüm thread'i, 0 = donanım
+    size_t memoryBudget = 0;     // şerit buffer'ları (bayt), 0 = varsayılan
+    bool inkAnalysis = false;
+    InkOptions ink;
+    std::shared_ptr<TileCache> tileCache;   // işler arasında paylaşılabilir, bkz. setTileCache
+};
+
+struct JobResult {
+    JobState state = JobState::Queued;
+    std::string error;           // Failed ise
+    PipelineStats stats;         // görüntü işlerinde
+    InkStats ink;                // inkAnalysis açıksa
+};
+
+// Kuyruktaki bir işin tutamacı. Sorgular ve cancel herhangi bir thread'den
+// çağrılabilir; tutamaç bırakılsa da iş sürer.
+class ConversionJob {
+public:
+    uint64_t id() const { return jobId; }
+    JobState state() const { return currentState.load(std::memory_order_acquire); }
+    bool finished() const;
+
+    // Son bildirilen ilerleme (şerit/parça başına güncellenir)
+    ConversionProgress progress() const;
+
+    // Kuyrukta bekleyen iş hiç başlamaz; süren iş bir sonraki şerit veya
+    // parça sınırında durur. Bitmiş işte etkisizdir.
+    void cancel() { token.cancel(); }
+
+    // İş bitene kadar bekler
+    const JobResult& wait() const { return result.get(); }
+    bool waitFor(std::chrono::milliseconds timeout) const;
+
+    std::shared_future<JobResult> future() const { return result; }
+
+private:
+    friend class ConversionQueue;
+
+    ConversionJob(uint64_t id, ProgressCallback onProgress);
+    void report(const ConversionProgress& progress);
+    void finish(JobResult finalResult);
+
+    uint64_t jobId;
+    CancelToken token;
+    ProgressCallback callback;
+    std::atomic<JobState> currentState;
+    // Yapılan ve toplam tek atomik kelimede (üst/alt 32 bit), tutarlı okunur
+    std::atomic<uint64_t> rows;
+    std::atomic<uint64_t> strips;
+    std::promise<JobResult> promise;
+    std::shared_future<JobResult> result;
+};
+
+// İşleri kütüphanenin ThreadPool'unda sırayla (en fazla concurrentJobs
+// tanesi aynı anda) yürüten eşzamansız arayüz:
+//
+//   ConversionQueue queue(1);
+//   auto job = queue.submit(request, [](const ConversionProgress& p) { ... });
+//   ...
+//   job->cancel();
+//   const JobResult& result = job->wait();
+//
+// ImageColorConverter'lar işler arasında tekrar kullanılır, böylece
+// şerit arenası ve TransformCache'teki transform'lar sıcak kalır. İş başına
+// thread sayısı ile concurrentJobs'un çarpımı çekirdek sayısını aşmamalıdır.
+// Yıkıcı bekleyen ve süren işleri iptal edip bitmelerini bekler.
+class ConversionQueue {
+public:
+    explicit ConversionQueue(unsigned concurrentJobs = 1);
+    ~ConversionQueue();
+
+    ConversionQueue(const ConversionQueue&) = delete;
+    ConversionQueue& operator=(const ConversionQueue&) = delete;
+
+    // onProgress işin encode thread'inden her şerit yazıldıktan sonra çağrılır
+    std::shared_ptr<ConversionJob> submit(const ConversionRequest& request,
+                                          ProgressCallback onProgress = ProgressCallback());
+
+    // Bellekteki width x height görüntünün dönüşümü; satır grupları halinde
+    // ilerleme bildirir ve aralarında iptal kontrol eder. converter ve
+    // buffer'lar iş bitene kadar yaşamalıdır. Stride'lar bayt, 0 = sıkışık.
+    std::shared_ptr<ConversionJob> submit(const ColorConverter& converter,
+                                          const void* input, PixelFormat inputFormat, size_t inputStride,
+                                          void* output, PixelFormat outputFormat, size_t outputStride,
+                                          size_t width, size_t height,
+                                          ProgressCallback onProgress = ProgressCallback());
+
+    void cancelAll();
+
+    // Bekleyen ve süren iş sayısı
+    size_t activeJobs() const;
+
+private:
+    std::shared_ptr<ConversionJob> track(ProgressCallback onProgress);
+    std::unique_ptr<ImageColorConverter> acquire();
+    void recycle(std::unique_ptr<ImageColorConverter> converter);
+
+    mutable std::mutex mutex;
+    std::vector<std::weak_ptr<ConversionJob>> jobs;
+    std::vector<std::unique_ptr<ImageColorConverter>> idle;
+    uint64_t nextId;
+    // En son üye: önce yıkılır, bekleyen görevler diğer üyeler yaşarken biter
+    ThreadPool pool;
+};
+
+#endif // CONVERSION_JOB_HPP
@@ -0,0 +1,78 @@
+#ifndef CONVERTER_HPP
+#define CONVERTER_HPP
+
+#include "color/ColorConverter.hpp"
+#include "color/PixelDescriptor.hpp"
+#include "color/ThreadPool.hpp"
+#include <cstddef>
+
+// Format çifti derleme zamanında sabit dönüştürücü:
+//
+//   Converter<RGB8, CMYK16> fast(converter);
+//   fast.convert(rgbPixels, cmykPixels, count);
+//
+// bind, kaynak ColorConverter'ın bu çift için LUT'unu veya lcms
+// transform'unu (PixelDescriptor'daki TYPE_* formatlarıyla) bir kez seçer;
+// convert'te format kontrolü, tablo araması ve tip dönüşümü yoktur. LUT
+// yolu Lut3D'nin bu çift için örneklenmiş çekirdeğini çağırır.
+//
+// Kaynağın thread havuzu, parça boyutu ve ölçümleri kullanılır. Bağlı
+// Converter kaynak yaşadıkça ve yeniden initialize edilmedikçe geçerlidir;
+// const olduğundan aynı anda birden çok thread'den çağrılabilir. Az renkli
+// girdi belleği ve mürekkep istatistiği yoktur (bkz. ColorConverter::convert).
+template <typename In, typename Out>
+class Converter {
+public:
+    using Input = PixelDescriptor<In>;
+    using Output = PixelDescriptor<Out>;
+
+    static_assert(Input::rgb && !Output::rgb, "Converter RGB girdiyi CMYK çıktıya dönüştürür");
+
+    Converter() = default;
+    explicit Converter(const ColorConverter& source) { bind(source); }
+
+    bool bind(const ColorConverter& source) {
+        owner = nullptr;
+        if (!source.prepare(Input::format, Output::format, false, table, transform)) return false;
+        owner = &source;
+        return true;
+    }
+
+    bool valid() const { return owner != nullptr; }
+
+    TransformEngine engine() const {
+        if (table) return TransformEngine::Lut;
+        return TransformCache::engineOf(transform);
+    }
+
+    bool convert(const In* input, Out* output, size_t pixelCount) const {
+        if (!owner) return false;
+        Instrumentation::Scope scope(*owner->instr, Stage::TransformExecute);
+        owner->instr->addPixels(pixelCount, pixelCount * Input::bytes, pixelCount * Output::bytes);
+
+        const size_t chunk = owner->chunkPixels;
+        if (!owner->pool || pixelCount <= chunk) {
+            run(input, output, pixelCount);
+            return true;
+        }
+        owner->pool->parallelFor(pixelCount, chunk, [&](size_t begin, size_t end) {
+            run(input + begin, output + begin, end - begin);
+        });
+        return true;
+    }
+
+private:
+    void run(const In* input, Out* output, size_t pixelCount) const {
+        if (table) {
+            table->apply(input, output, pixelCount);
+        } else {
+            cmsDoTransform(transform, input, output, static_cast<cmsUInt32Number>(pixelCount));
+        }
+    }
+
+    const ColorConverter* owner = nullptr;
+    const Lut3D* table = nullptr;
+    cmsHTRANSFORM transform = nullptr;
+};
+
+#endif // CONVERTER_HPP
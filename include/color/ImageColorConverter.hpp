@@ -0,0 +1,187 @@
+#ifndef IMAGE_COLOR_CONVERTER_HPP
+#define IMAGE_COLOR_CONVERTER_HPP
+
+#include "color/ColorConverter.hpp"
+#include "color/ImageReader.hpp"
+#include "color/ScratchArena.hpp"
+#include "color/TileCache.hpp"
+#include "color/TiffWriter.hpp"
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+// Pipeline aşaması başına ölçülen süreler
+struct StageTiming {
+    double busySeconds = 0;   // iş yaparken geçen süre
+    double idleSeconds = 0;   // kuyruk beklerken geçen süre
+};
+
+struct PipelineStats {
+    StageTiming decode;
+    StageTiming transform;
+    StageTiming encode;
+    double wallSeconds = 0;
+    size_t strips = 0;
+    size_t tiles = 0;         // tile cache etkinse yazılan tile sayısı
+    size_t cachedTiles = 0;   // bunlardan cache'ten gelen
+
+    // En çok meşgul kalan aşama darboğazdır
+    const char* bottleneck() const {
+        if (decode.busySeconds >= transform.busySeconds && decode.busySeconds >= encode.busySeconds)
+            return "decode";
+        return transform.busySeconds >= encode.busySeconds ? "transform" : "encode";
+    }
+};
+
+// convertImage ilerlemesi: yazılmış satır ve şerit sayısı
+struct ConversionProgress {
+    uint32_t rowsDone = 0;
+    uint32_t totalRows = 0;
+    size_t stripsDone = 0;
+    size_t totalStrips = 0;
+
+    double fraction() const { return totalRows ? static_cast<double>(rowsDone) / totalRows : 0.0; }
+};
+
+// Her şerit TIFF'e yazıldıktan sonra encode thread'inden çağrılır; kısa sürmelidir
+using ProgressCallback = std::function<void(const ConversionProgress&)>;
+
+// İşbirlikçi iptal bayrağı. Kopyalar aynı bayrağı paylaşır; cancel herhangi
+// bir thread'den çağrılabilir, dönüşüm bir sonraki şerit sınırında durur.
+class CancelToken {
+public:
+    CancelToken() : flag(std::make_shared<std::atomic<bool>>(false)) {}
+
+    void cancel() const { flag->store(true, std::memory_order_relaxed); }
+    bool cancelled() const { return flag->load(std::memory_order_relaxed); }
+
+private:
+    std::shared_ptr<std::atomic<bool>> flag;
+};
+
+// Görüntü dosyasını RGB -> CMYK dönüştürüp 16-bit CMYK TIFF olarak yazar.
+// Dönüşüm satır şeritleri (strip) halinde üç aşamalı bir pipeline ile yapılır:
+// decode (ayrı thread) -> transform (çağıran thread) -> encode (ayrı thread).
+// Aşamalar sınırlı kuyruklarla bağlıdır ve aynı anda çalışır; toplam süre
+// aşamaların toplamına değil en yavaş aşamaya yaklaşır. Çalışma belleği görüntü
+// yüksekliğinden bağımsızdır ve setMemoryBudget ile sınırlanır.
+//
+// Girdi dosyası bellek eşlemesiyle okunur ve ImageReader ile şerit şerit
+// çözülür (libpng/libjpeg derlendiyse onlarla, aksi halde stb_image).
+// Şerit buffer'ları, stb'nin çözülmüş görüntüsü ve ICC profili çağrılar
+// arasında tekrar kullanılan bir arenadan gelir; aynı nesneyle art arda
+// dönüştürülen görüntüler ilk çağrıdan sonra büyük heap ayırması yapmaz.
+class ImageColorConverter {
+public:
+    ImageColorConverter();
+
+    bool initialize(const std::string& rgbProfilePath,
+                    const std::string& cmykProfilePath);
+
+    bool initialize(const std::string& rgbProfilePath,
+                    const std::string& cmykProfilePath,
+                    const ConversionOptions& options);
+
+    bool initialize(const CachedProfile& rgbProfile,
+                    const CachedProfile& cmykProfile,
+                    const ConversionOptions& options = ConversionOptions());
+
+    // Başka bir converter'ın durumuyla (pişmiş LUT paylaşılır)
+    bool initialize(const ColorConverter& source);
+
+    bool convertImage(const std::string& inputPath,
+                      const std::string& outputPath);
+
+    // İlerleme bildiren ve iptal edilebilen dönüşüm. cancel şeritler arasında
+    // kontrol edilir; iptalde yarım çıktı silinir, false döner ve
+    // lastCancelled() true olur. Eşzamansız işler için bkz. ConversionQueue.
+    bool convertImage(const std::string& inputPath,
+                      const std::string& outputPath,
+                      const ProgressCallback& onProgress,
+                      const CancelToken& cancel);
+
+    // Şerit buffer'larına ayrılacak üst sınır (bayt). Şerit en az bir satırdır.
+    void setMemoryBudget(size_t bytes);
+    size_t getMemoryBudget() const { return memoryBudget; }
+
+    // Aynı anda dolaşımda olan şerit sayısı (kuyruk derinliği)
+    void setPipelineDepth(size_t strips);
+    size_t getPipelineDepth() const { return pipelineDepth; }
+
+    // Tercih edilen çözücü; derlenmemişse veya dosya türüne uymuyorsa stb
+    void setImageBackend(ImageBackend backend) { imageBackend = backend; }
+    ImageBackend getImageBackend() const { return imageBackend; }
+    // Son convertImage çağrısında kullanılan çözücü
+    ImageBackend lastImageBackend() const { return lastBackend; }
+
+    // Çıktı düzeni, sıkıştırma ve BigTIFF seçimi. Varsayılan: LZW strip'ler.
+    void setTiffOptions(const TiffWriteOptions& options) { tiffOptions = options; }
+    const TiffWriteOptions& getTiffOptions() const { return tiffOptions; }
+
+    // Verilirse tile'lı çıktıda her girdi tile'ı xxHash ile özetlenir; aynı
+    // içerik ve ayarlarla daha önce yazılmış tile'lar dönüştürülüp
+    // sıkıştırılmadan cache'ten yazılır, yeni tile'lar cache'e eklenir.
+    // Küçük bir düzenlemeden sonra tekrar dışa aktarmanın maliyeti değişen
+    // alanla orantılı olur (çözme yine tüm görüntü için yapılır). Şerit
+    // düzeni, düzlemsel çıktı, piramit ve mürekkep analizinde kullanılmaz.
+    void setTileCache(std::shared_ptr<TileCache> cache) { tileCache = std::move(cache); }
+    const std::shared_ptr<TileCache>& getTileCache() const { return tileCache; }
+
+    // Verilen genişlik için bütçeye sığan şerit yüksekliği
+    int rowsPerStrip(int width) const;
+
+    // Açıksa her şeridin TAC/kapsama istatistiği dönüşümle aynı geçişte
+    // toplanır ve inkOptions'taki TAC sınırı uygulanır. Düzlemsel çıktıda
+    // desteklenmez (istatistik boş kalır).
+    void setInkAnalysis(bool enabled, const InkOptions& options = InkOptions()) {
+        inkEnabled = enabled;
+        inkOptions = options;
+        inkOptions.tacLimit = clampTacLimit(options.tacLimit);
+    }
+
+    // Son convertImage çağrısının mürekkep istatistikleri; maxTacPixel
+    // görüntüdeki satır sıralı piksel indeksidir
+    const InkStats& lastInkStats() const { return ink; }
+
+    // Son convertImage çağrısının aşama süreleri
+    const PipelineStats& lastPipelineStats() const { return stats; }
+
+    // Son başarısız convertImage çağrısının hata mesajı
+    const std::string& lastError() const { return errorMessage; }
+
+    // Son convertImage çağrısı iptal edildi mi
+    bool lastCancelled() const { return cancelled; }
+
+    // Girdi/çıktı yollarını stdout'a yaz (varsayılan açık)
+    void setVerbose(bool on) { verbose = on; }
+
+    ColorConverter& colorConverter() { return converter; }
+
+    // Çağrılar arasında tutulan buffer havuzu (sınır: setRetainLimit)
+    ScratchArena& scratchArena() { return arena; }
+
+private:
+    bool run(const std::string& inputPath, const std::string& outputPath,
+             const ProgressCallback* onProgress, const CancelToken* cancel);
+
+    ColorConverter converter;
+    size_t memoryBudget;
+    size_t pipelineDepth;
+    PipelineStats stats;
+    ImageBackend imageBackend;
+    ImageBackend lastBackend;
+    bool inkEnabled;
+    InkOptions inkOptions;
+    InkStats ink;
+    TiffWriteOptions tiffOptions;
+    TiffWriter writer;
+    std::shared_ptr<TileCache> tileCache;
+    ScratchArena arena;
+    std::string errorMessage;
+    bool cancelled;
+    bool verbose;
+};
+
+#endif // IMAGE_COLOR_CONVERTER_HPP
@@ -0,0 +1,64 @@
+#ifndef IMAGE_READER_HPP
+#define IMAGE_READER_HPP
+
+#include "color/ColorTypes.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Görüntü çözücü arka ucu. stb_image her zaman vardır; libpng ve
+// libjpeg(-turbo) CMake'te bulunursa derlenir (COLOR_USE_LIBPNG / COLOR_USE_LIBJPEG).
+enum class ImageBackend {
+    Auto,       // dosya imzasına göre derlenmiş en hızlı arka uç
+    Stb,
+    LibPng,
+    LibJpeg
+};
+
+const char* backendName(ImageBackend backend);
+
+struct ImageInfo {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    unsigned channels = 0;      // dosyadaki kanal sayısı; çıktı her zaman RGB8
+};
+
+// Bellekteki (ör. eşlenmiş) dosyadan satır sırasıyla RGB8 çözen okuyucu.
+// Satır satır çözebilen arka uçlar (libpng, libjpeg) readRows çağrısı başına
+// yalnızca istenen satırları çözer; böylece pipeline dosyanın tamamı
+// çözülmeden dönüşüme başlar. stb ilk çağrıda görüntünün tamamını çözer.
+//
+// Veri okuyucu yaşadığı sürece geçerli kalmalıdır. Hatalarda false döner,
+// neden error() ile alınır.
+class ImageReader {
+public:
+    virtual ~ImageReader() = default;
+
+    // Başlığı okur; boyutlar info() ile alınır
+    virtual bool open(const uint8_t* data, size_t size) = 0;
+
+    // Sıradaki rows satırı out'a yazar; stride satırlar arası bayt (0 = sıkışık)
+    virtual bool readRows(RGB8* out, size_t stride, uint32_t rows) = 0;
+
+    virtual ImageBackend backend() const = 0;
+
+    const ImageInfo& info() const { return imageInfo; }
+    const std::string& error() const { return errorMessage; }
+
+    // İstenen arka uç derlenmemişse veya dosya türüne uymuyorsa stb'ye düşülür.
+    // Açılamazsa nullptr; neden errorOut'a yazılır.
+    static std::unique_ptr<ImageReader> create(const uint8_t* data, size_t size,
+                                               ImageBackend preferred = ImageBackend::Auto,
+                                               std::string* errorOut = nullptr);
+
+    // Arka uç bu derlemede var mı
+    static bool available(ImageBackend backend);
+
+protected:
+    ImageInfo imageInfo;
+    std::string errorMessage;
+    uint32_t nextRow = 0;
+};
+
+#endif // IMAGE_READER_HPP
@@ -0,0 +1,53 @@
+#ifndef INK_STATISTICS_HPP
+#define INK_STATISTICS_HPP
+
+#include "color/ColorTypes.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Baskı öncesi kontrol için mürekkep istatistiği ayarları
+struct InkOptions {
+    bool histograms = true;         // kanal başına 256 kutulu histogram
+    // Toplam mürekkep (TAC) sınırı, yüzde (0..400); 0 = sınır yok
+    double tacLimit = 0.0;
+    // Sınırı aşan piksellerde C, M, Y orantılı azaltılır, K korunur
+    bool enforceTacLimit = false;
+};
+
+// TAC sınırını 0..400 aralığına çeker; NaN ve negatif değerler 0 (sınır yok)
+double clampTacLimit(double percent);
+
+// Dönüştürülmüş CMYK çıktının mürekkep kapsaması. Değerler çıktı örnek
+// ölçeğindedir (CMYK8: 0..255, CMYK16: 0..65535); yüzdeler için yardımcı
+// fonksiyonlar kullanılır. enforceTacLimit açıksa istatistikler sınırlanmış
+// çıktıyı tanımlar.
+struct InkStats {
+    uint64_t pixels = 0;
+    uint32_t sampleMax = 0;                     // 255 veya 65535
+    std::array<uint64_t, 4> channelSum{};
+    std::array<uint32_t, 4> channelMax{};
+    uint32_t maxTac = 0;                        // 4 kanal toplamı
+    size_t maxTacPixel = 0;                     // en yüksek TAC'ın ilk görüldüğü piksel
+    uint64_t overLimitPixels = 0;               // sınırı aşan (sınırlamadan önce)
+    // Kanal başına değer histogramı; 16-bit'te üst bayta göre kutulanır
+    std::array<std::array<uint64_t, 256>, 4> histogram{};
+
+    // Kanalın ortalama kapsaması (%)
+    double averageCoverage(size_t channel) const;
+    // Ortalama ve en yüksek toplam mürekkep (%, 400'e kadar)
+    double averageTac() const;
+    double maxTacPercent() const;
+
+    // Başka bir parçanın sonucunu ekler (thread'lerin kısmi sonuçları);
+    // eşit TAC'ta küçük piksel indeksi kalır, böylece sıra önemsizdir
+    void merge(const InkStats& other);
+};
+
+// Bellekteki CMYK8/CMYK16 parçasının istatistiğini stats'a ekler; gerekirse
+// TAC sınırını yerinde uygular. firstPixel parçanın görüntüdeki ilk
+// pikselidir (maxTacPixel için). İndirgemeler AVX2 varsa vektörle yapılır.
+void accumulateInk(void* cmyk, PixelFormat format, size_t pixelCount, size_t firstPixel,
+                   const InkOptions& options, InkStats& stats);
+
+#endif // INK_STATISTICS_HPP
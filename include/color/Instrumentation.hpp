@@ -0,0 +1,132 @@
+#ifndef INSTRUMENTATION_HPP
+#define INSTRUMENTATION_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Ölçülen sıcak yol aşamaları
+enum class Stage {
+    ProfileOpen,
+    TransformBuild,
+    TransformExecute,
+    ImageDecode,
+    TiffWrite,
+    Count
+};
+
+constexpr size_t kStageCount = static_cast<size_t>(Stage::Count);
+
+struct StageStats {
+    uint64_t calls = 0;
+    uint64_t totalNanos = 0;
+    uint64_t maxNanos = 0;
+
+    double totalSeconds() const { return totalNanos / 1e9; }
+    double averageMicros() const { return calls ? totalNanos / 1e3 / calls : 0.0; }
+};
+
+// Instrumentation::snapshot ile alınan, kopyalanabilir anlık görüntü
+struct InstrumentationStats {
+    std::array<StageStats, kStageCount> stages{};
+    uint64_t pixels = 0;          // dönüştürülen piksel
+    uint64_t inputBytes = 0;      // transform girdisi
+    uint64_t outputBytes = 0;     // transform çıktısı
+    uint64_t tiffBytes = 0;       // TIFF'e verilen (sıkıştırılmamış) bayt
+    uint64_t allocations = 0;     // kütüphanenin büyük buffer ayırmaları
+    uint64_t allocatedBytes = 0;
+
+    const StageStats& stage(Stage s) const { return stages[static_cast<size_t>(s)]; }
+};
+
+// İsteğe bağlı, düşük maliyetli ölçüm. Kapalıyken (varsayılan) her ölçüm
+// noktası yalnızca tek bir atomik okumadır. Açıkken sayaçlar atomik olarak
+// toplanır; izleme (tracing) ayrıca açılırsa her aşama bir olay olarak
+// saklanır ve Chrome/Perfetto trace JSON'u olarak dışa aktarılabilir.
+class Instrumentation {
+public:
+    Instrumentation();
+
+    Instrumentation(const Instrumentation&) = delete;
+    Instrumentation& operator=(const Instrumentation&) = delete;
+
+    void setEnabled(bool on) { enabledFlag.store(on, std::memory_order_relaxed); }
+    bool enabled() const { return enabledFlag.load(std::memory_order_relaxed); }
+
+    // İzleme sayaçları da açar. maxEvents dolunca yeni olaylar düşürülür.
+    void setTracing(bool on, size_t maxEvents = 1u << 16);
+    bool tracing() const { return tracingFlag.load(std::memory_order_relaxed); }
+
+    // Kapsam boyunca süren aşama ölçümü
+    class Scope {
+    public:
+        Scope(Instrumentation& owner, Stage stage)
+            : owner(owner.enabled() ? &owner : nullptr), stage(stage) {
+            if (this->owner) start = std::chrono::steady_clock::now();
+        }
+        ~Scope() {
+            if (owner) owner->record(stage, start, std::chrono::steady_clock::now());
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Instrumentation* owner;
+        Stage stage;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    void addPixels(uint64_t pixels, uint64_t inputBytes, uint64_t outputBytes);
+    void addTiffBytes(uint64_t bytes);
+    void addAllocation(uint64_t bytes);
+
+    InstrumentationStats snapshot() const;
+    void reset();
+
+    // {"traceEvents": [...]} biçiminde; chrome://tracing veya ui.perfetto.dev açar
+    std::string chromeTraceJson() const;
+    bool writeChromeTrace(const std::string& path) const;
+
+    static const char* stageName(Stage stage);
+
+private:
+    struct AtomicStage {
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> totalNanos{0};
+        std::atomic<uint64_t> maxNanos{0};
+    };
+
+    struct TraceEvent {
+        Stage stage;
+        uint32_t thread;
+        int64_t startMicros;
+        int64_t durationMicros;
+    };
+
+    void record(Stage stage, std::chrono::steady_clock::time_point start,
+                std::chrono::steady_clock::time_point end);
+
+    std::atomic<bool> enabledFlag{false};
+    std::atomic<bool> tracingFlag{false};
+
+    std::array<AtomicStage, kStageCount> stages;
+    std::atomic<uint64_t> pixels{0};
+    std::atomic<uint64_t> inputBytes{0};
+    std::atomic<uint64_t> outputBytes{0};
+    std::atomic<uint64_t> tiffBytes{0};
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> allocatedBytes{0};
+
+    std::chrono::steady_clock::time_point epoch;   // traceMutex ile korunur
+    mutable std::mutex traceMutex;
+    std::vector<TraceEvent> events;
+    size_t maxEvents;
+};
+
+#endif // INSTRUMENTATION_HPP
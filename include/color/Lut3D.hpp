@@ -0,0 +1,87 @@
+#ifndef LUT3D_HPP
+#define LUT3D_HPP
+
+#include <lcms2.h>
+#include "color/ColorTypes.hpp"
+#include <cstddef>
+#include <memory>
+
+// LUT'un lcms referansına göre doğruluğu (CIEDE2000)
+struct LutAccuracy {
+    double maxDeltaE = 0;
+    double meanDeltaE = 0;
+    size_t samples = 0;
+};
+
+// RGB -> CMYK transform'unun N x N x N ızgarada önceden hesaplanmış hali.
+// Düğümler kanal başına ayrı, 64 bayt hizalı float düzlemlerinde (SoA) tutulur;
+// değerlendirme tetrahedral interpolasyonla yapılır (AVX2 varsa 8 piksel birden).
+// Oluşturulduktan sonra değişmez; apply aynı anda birden çok thread'den çağrılabilir.
+class Lut3D {
+public:
+    Lut3D();
+    ~Lut3D();
+
+    Lut3D(const Lut3D&) = delete;
+    Lut3D& operator=(const Lut3D&) = delete;
+
+    // RGB16 -> CMYK16 transform'u her ızgara düğümünde örnekleyerek doldurur.
+    // gridPoints eksen başına düğüm sayısıdır (2..256), ör. 33 veya 65.
+    bool build(cmsHTRANSFORM rgb16ToCmyk16, unsigned gridPoints);
+
+    // Dışarıda tutulan düğümleri (ör. bellek eşlemeli cache dosyası) kopyalamadan
+    // kullanır. planes 64 bayt hizalı, 4 * planeStride float olmalı; owner
+    // LUT yaşadıkça belleği canlı tutar.
+    bool assign(unsigned gridPoints, size_t planeStride, const float* planes,
+                std::shared_ptr<const void> owner);
+
+    bool empty() const { return grid == 0; }
+    unsigned gridPoints() const { return grid; }
+    size_t memoryBytes() const;
+
+    // Serileştirme için ham düğüm düzlemleri (C, M, Y, K sırasıyla)
+    const float* planeData() const { return planes; }
+    size_t getPlaneStride() const { return planeStride; }
+
+    // gridPoints için düzlem uzunluğu (16 float'ın katına yuvarlanmış)
+    static size_t planeStrideFor(unsigned gridPoints);
+
+    // Girdi RGB8/RGBA8/RGB16, çıktı CMYK8/CMYK16 olabilir
+    static bool supports(PixelFormat inputFormat, PixelFormat outputFormat);
+
+    bool apply(const void* input, PixelFormat inputFormat,
+               void* output, PixelFormat outputFormat,
+               size_t pixelCount) const;
+
+    // Derleme zamanında seçilen çekirdek; LUT boş olmamalıdır. Yalnızca
+    // RGB8/RGBA8/RGB16 -> CMYK8/CMYK16 çiftleri için örneklenmiştir.
+    template <typename In, typename Out>
+    void apply(const In* input, Out* output, size_t pixelCount) const;
+
+    // Çıktı C, M, Y, K için ayrı düzlemlere (her biri pixelCount eleman)
+    bool applyPlanar(const void* input, PixelFormat inputFormat,
+                     const CMYKPlanes& output, PixelFormat outputFormat,
+                     size_t pixelCount) const;
+
+    // Eksen başına samplesPerAxis örnekle (düğümlerin arasına denk gelecek
+    // şekilde) LUT çıktısını referans transform'la CMYK profilinin Lab
+    // karşılığında karşılaştırır.
+    LutAccuracy measureAccuracy(cmsHTRANSFORM rgb16ToCmyk16, cmsHPROFILE cmykProfile,
+                                unsigned samplesPerAxis = 32) const;
+
+    // Çalışma anında seçilen interpolasyon çekirdeği ("avx2", "neon" veya "scalar")
+    static const char* kernelName();
+
+private:
+    // channels[c] kanal c'nin ilk elemanı; ardışık pikseller step eleman arayla
+    bool run(const void* input, PixelFormat inputFormat,
+             void* const channels[4], size_t step, PixelFormat outputFormat,
+             size_t pixelCount) const;
+
+    unsigned grid;
+    size_t planeStride;     // bir kanal düzleminin (dolgulu) float sayısı
+    const float* planes;
+    std::shared_ptr<const void> storage;
+};
+
+#endif // LUT3D_HPP
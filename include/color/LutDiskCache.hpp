@@ -0,0 +1,44 @@
+#ifndef LUT_DISK_CACHE_HPP
+#define LUT_DISK_CACHE_HPP
+
+#include "color/Lut3D.hpp"
+#include "color/TransformCache.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Diskteki LUT'u tanımlayan her şey; biri değişirse dosya geçersizdir
+struct LutCacheKey {
+    ProfileId input{};
+    ProfileId output{};
+    uint32_t intent = 0;
+    uint32_t flags = 0;
+    uint32_t gridPoints = 0;
+};
+
+// Pişirilmiş 3D LUT'ları süreçler arası paylaşmak için dosya cache'i.
+// Kısa ömürlü worker'lar cmsCreateTransform + örnekleme yerine dosyayı bellek
+// eşlemesiyle açar; düğümler kopyalanmadan doğrudan eşlemeden okunur.
+//
+// Dosya: 64 baytlık başlık (sihirli sözcük, sürüm, bayt sırası, anahtar,
+// düzlem uzunluğu) ve ardından 4 float düzlem. Başlık, sürüm veya boyut
+// uyuşmazsa dosya yok sayılır ve LUT yeniden oluşturulur. Yazma geçici dosyaya
+// yapılıp yeniden adlandırıldığı için okuyucular yarım dosya görmez.
+class LutDiskCache {
+public:
+    static constexpr uint32_t kFormatVersion = 1;
+
+    explicit LutDiskCache(std::string directory);
+
+    const std::string& getDirectory() const { return directory; }
+    std::string pathFor(const LutCacheKey& key) const;
+
+    // Dosya yoksa veya geçersizse nullptr
+    std::shared_ptr<const Lut3D> load(const LutCacheKey& key) const;
+    bool store(const LutCacheKey& key, const Lut3D& lut) const;
+
+private:
+    std::string directory;
+};
+
+#endif // LUT_DISK_CACHE_HPP
@@ -0,0 +1,36 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Dosyanın salt okunur bellek eşlemesi (POSIX mmap / Win32 MapViewOfFile).
+// Sayfalar ilk erişimde diskten (veya sayfa önbelleğinden) okunur.
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return base != nullptr; }
+    const uint8_t* data() const { return static_cast<const uint8_t*>(base); }
+    size_t size() const { return length; }
+
+private:
+    void* base;
+    size_t length;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+};
+
+#endif // MAPPED_FILE_HPP
@@ -0,0 +1,36 @@
+#ifndef PIXEL_DESCRIPTOR_HPP
+#define PIXEL_DESCRIPTOR_HPP
+
+#include <lcms2.h>
+#include "color/ColorTypes.hpp"
+
+// PixelFormat'ın lcms2 karşılığı (TYPE_*); transform bu formatlarla kurulur
+constexpr cmsUInt32Number lcmsFormatOf(PixelFormat format) {
+    switch (format) {
+        case PixelFormat::RGB8:   return TYPE_RGB_8;
+        case PixelFormat::RGBA8:  return TYPE_RGBA_8;
+        case PixelFormat::RGB16:  return TYPE_RGB_16;
+        case PixelFormat::CMYK8:  return TYPE_CMYK_8;
+        case PixelFormat::CMYK16: return TYPE_CMYK_16;
+    }
+    return 0;
+}
+
+// Piksel tipinin derleme zamanı tanımı: PixelTraits + lcms formatı ve bayt
+// boyutu. Converter<In, Out> tüm seçimlerini buradan yapar.
+template <typename Pixel>
+struct PixelDescriptor : PixelTraits<Pixel> {
+    using Traits = PixelTraits<Pixel>;
+    static constexpr cmsUInt32Number lcmsType = lcmsFormatOf(Traits::format);
+    static constexpr size_t bytes = bytesPerPixel(Traits::format);
+
+    static_assert(bytes == sizeof(Pixel), "piksel struct'ı dolgusuz olmalı");
+    static_assert(bytes == Traits::channels * sizeof(typename Traits::Sample),
+                  "kanal sayısı ve örnek tipi formatla uyuşmuyor");
+    static_assert(T_BYTES(lcmsType) == sizeof(typename Traits::Sample),
+                  "lcms formatının örnek boyutu uyuşmuyor");
+    static_assert(T_CHANNELS(lcmsType) == Traits::colorChannels,
+                  "lcms formatının kanal sayısı uyuşmuyor");
+};
+
+#endif // PIXEL_DESCRIPTOR_HPP
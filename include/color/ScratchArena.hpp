@@ -0,0 +1,87 @@
+#ifndef SCRATCH_ARENA_HPP
+#define SCRATCH_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+class Instrumentation;
+
+struct ScratchStats {
+    uint64_t heapAllocations = 0;   // havuzda uygun blok yokken yapılan ayırmalar
+    uint64_t heapBytes = 0;
+    uint64_t reuses = 0;            // havuzdan karşılanan istekler
+    size_t cachedBytes = 0;         // şu an havuzda bekleyen bloklar
+};
+
+// Büyük geçici buffer'lar için tekrar kullanılan blok havuzu. Bloklar
+// bırakıldığında işletim sistemine iade edilmez; aynı boyutta (en fazla iki
+// katı) bir sonraki istek sayfaları zaten eşlenmiş bloğu alır. Böylece uzun
+// çalışan bir worker kararlı durumda büyük heap ayırması ve sayfa hatası yapmaz.
+//
+// Her blok 64 bayt hizalıdır ve başlığında sahibi olan arenayı taşır; release
+// hangi thread'den çağrılırsa çağrılsın bloğu doğru yere döndürür. Arena
+// yok edilmeden önce verdiği tüm bloklar bırakılmış olmalıdır.
+class ScratchArena {
+public:
+    explicit ScratchArena(size_t retainLimit = kDefaultRetainLimit);
+    ~ScratchArena();
+
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    void* allocate(size_t bytes);
+    void* reallocate(void* block, size_t bytes);
+
+    // Arenadan veya (bağlı arena yokken) heap'ten gelen bloğu bırakır
+    static void release(void* block);
+
+    // Havuzda tutulacak boş blokların toplam üst sınırı
+    void setRetainLimit(size_t bytes);
+    size_t getRetainLimit() const { return retainLimit; }
+
+    // Havuzdaki boş blokları serbest bırakır
+    void trim();
+
+    ScratchStats stats() const;
+
+    // Heap'e giden her ayırma Instrumentation::addAllocation'a yazılır
+    void setInstrumentation(Instrumentation* instrumentation) { instr = instrumentation; }
+
+    // Kapsam boyunca bu thread'deki threadAllocate çağrıları arenaya gider.
+    // stb_image'ın ayırmaları bu yolla havuzdan karşılanır.
+    class Binding {
+    public:
+        explicit Binding(ScratchArena& arena);
+        ~Binding();
+        Binding(const Binding&) = delete;
+        Binding& operator=(const Binding&) = delete;
+    private:
+        ScratchArena* previous;
+    };
+
+    static void* threadAllocate(size_t bytes);
+    static void* threadReallocate(void* block, size_t bytes);
+
+    static constexpr size_t kDefaultRetainLimit = 512u * 1024 * 1024;
+
+    // Bundan küçük istekler havuza girmez, doğrudan heap'ten gelir
+    static constexpr size_t kMinPooledBytes = 64u * 1024;
+
+private:
+    struct FreeBlock {
+        void* block;
+        size_t capacity;
+    };
+
+    void recycle(void* block, size_t capacity);
+
+    mutable std::mutex mutex;
+    std::vector<FreeBlock> freeBlocks;   // eskiden yeniye
+    size_t retainLimit;
+    ScratchStats counters;
+    Instrumentation* instr;
+};
+
+#endif // SCRATCH_ARENA_HPP
@@ -0,0 +1,136 @@
+#ifndef SOFT_PROOFER_HPP
+#define SOFT_PROOFER_HPP
+
+#include <lcms2.h>
+#include "color/ColorTypes.hpp"
+#include "color/TransformCache.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class ThreadPool;
+
+// Ekranda gösterilecek bölge: tam çözünürlükteki kaynak dikdörtgeni ve
+// ekrandaki hedef boyutu (piksel)
+struct ProofView {
+    PixelRect source;
+    uint32_t targetWidth = 0;
+    uint32_t targetHeight = 0;
+};
+
+// Bir mip seviyesinde prova edilmiş görüntü parçası. region seviye
+// koordinatlarındadır (seviye L'de 1 piksel = 2^L kaynak piksel).
+struct ProofFrame {
+    uint64_t generation = 0;
+    unsigned level = 0;
+    PixelRect region;
+    std::vector<RGBA8> pixels;      // region.width * region.height, ekran profilinde
+    bool final = false;             // görünüm için gereken en ince seviye
+};
+
+struct SoftProofOptions {
+    cmsUInt32Number intent = INTENT_PERCEPTUAL;                 // kaynak -> baskı
+    cmsUInt32Number proofingIntent = INTENT_RELATIVE_COLORIMETRIC; // baskı -> ekran
+    bool gamutCheck = false;        // baskı gamı dışındakileri işaretle
+    // İlk (kaba) karenin üst sınırı; bir kare süresinde hazır olacak kadar küçük
+    size_t previewPixels = 256 * 1024;
+    unsigned threads = 0;           // seviye dönüşümü için, 0 = donanım
+};
+
+// Baskı önizlemesi (soft proof): RGB görüntü CMYK baskı profilinden geçirilip
+// ekran profilinde gösterilir (cmsCreateProofingTransform).
+//
+// setImage kaynağı bir kez kopyalayıp 2x2 kutu filtreli bir mip piramidi
+// kurar. request önce bütçeye sığan kaba bir seviyeyi, ardından arka planda
+// görünüm için gereken seviyeye kadar her ince seviyeyi sırayla teslim eder.
+// Yeni bir request veya cancel, devam eden işi satır grupları arasında keser;
+// eski görünüme ait kareler geri çağrıya hiç verilmez.
+//
+// render ve request herhangi bir thread'den çağrılabilir; geri çağrı arka
+// plan thread'inde çalışır ve kısa sürmelidir.
+class SoftProofer {
+public:
+    using FrameCallback = std::function<void(const ProofFrame&)>;
+
+    SoftProofer();
+    ~SoftProofer();
+
+    SoftProofer(const SoftProofer&) = delete;
+    SoftProofer& operator=(const SoftProofer&) = delete;
+
+    // displayProfilePath boşsa ekran sRGB kabul edilir
+    bool initialize(const std::string& sourceProfilePath,
+                    const std::string& proofProfilePath,
+                    const std::string& displayProfilePath = std::string(),
+                    const SoftProofOptions& options = SoftProofOptions());
+
+    bool initialize(const CachedProfile& sourceProfile,
+                    const CachedProfile& proofProfile,
+                    const CachedProfile& displayProfile,
+                    const SoftProofOptions& options = SoftProofOptions());
+
+    // stride bayt cinsinden, 0 = sıkışık. Bekleyen işler iptal edilir.
+    void setImage(const RGBA8* pixels, uint32_t width, uint32_t height, size_t stride = 0);
+
+    unsigned levelCount() const;
+    uint32_t levelWidth(unsigned level) const;
+    uint32_t levelHeight(unsigned level) const;
+
+    // Görünümün ekran çözünürlüğünü karşılayan en kaba seviye
+    unsigned levelFor(const ProofView& view) const;
+    // Kırpılmış bölgesi previewPixels'e sığan en ince seviye (>= levelFor)
+    unsigned previewLevelFor(const ProofView& view) const;
+
+    // Tek seviyeyi eşzamanlı prova eder. expectedGeneration sıfır değilse ve
+    // iş sırasında kuşak değişirse false döner (iptal).
+    bool render(unsigned level, const PixelRect& source, ProofFrame& frame,
+                uint64_t expectedGeneration = 0) const;
+
+    // Kabadan inceye kareler üretir; dönen değer bu isteğin kuşağıdır
+    uint64_t request(const ProofView& view, FrameCallback onFrame);
+
+    // Devam eden isteği ve render'ları bırakır; yeni kuşağı döner
+    uint64_t cancel();
+
+    uint64_t currentGeneration() const { return generation.load(std::memory_order_acquire); }
+
+private:
+    struct Level {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<RGBA8> pixels;
+    };
+
+    struct Pending {
+        ProofView view;
+        FrameCallback onFrame;
+        uint64_t generation = 0;
+    };
+
+    void workerLoop();
+
+    // Seçenekler, piramit, transform ve havuz yalnızca setImage/initialize'da
+    // değişir; okuyanlar (worker dahil) kilit altında kopya alır
+    mutable std::mutex imageMutex;
+    SoftProofOptions options;
+    std::shared_ptr<void> transform;
+    std::shared_ptr<ThreadPool> pool;
+    std::shared_ptr<const std::vector<Level>> levels;
+
+    std::atomic<uint64_t> generation;
+
+    std::mutex requestMutex;
+    std::condition_variable requestReady;
+    std::unique_ptr<Pending> pending;
+    bool stopping;
+    std::thread worker;
+};
+
+#endif // SOFT_PROOFER_HPP
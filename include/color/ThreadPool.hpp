@@ -0,0 +1,44 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Sabit sayıda worker thread'i olan basit iş havuzu.
+class ThreadPool {
+public:
+    // threadCount = 0 ise donanım thread sayısı kullanılır
+    explicit ThreadPool(unsigned threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned threadCount() const { return static_cast<unsigned>(workers.size()); }
+
+    void submit(std::function<void()> task);
+
+    // [0, count) aralığını chunkSize boyutlu parçalara böler ve parçaları
+    // worker'lara dağıtır. Çağıran thread de parça işler; tüm parçalar
+    // bitmeden dönmez.
+    void parallelFor(size_t count, size_t chunkSize,
+                     const std::function<void(size_t begin, size_t end)>& body);
+
+    static unsigned hardwareThreads();
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool stopping;
+};
+
+#endif // THREAD_POOL_HPP
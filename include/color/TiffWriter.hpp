@@ -0,0 +1,163 @@
+#ifndef TIFF_WRITER_HPP
+#define TIFF_WRITER_HPP
+
+#include "color/ColorTypes.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class ThreadPool;
+struct tiff;
+
+enum class TiffCompression {
+    None,
+    Lzw,
+    Deflate,
+    Zstd
+};
+
+enum class TiffLayout {
+    Strips,
+    Tiles
+};
+
+enum class BigTiffMode {
+    Auto,       // sıkıştırılmamış boyut klasik TIFF sınırına yaklaşırsa
+    Always,
+    Never
+};
+
+struct TiffWriteOptions {
+    TiffCompression compression = TiffCompression::Lzw;
+    bool predictor = false;                 // yatay fark (PREDICTOR_HORIZONTAL)
+    TiffLayout layout = TiffLayout::Strips;
+    uint32_t stripRows = 0;                 // 0 = ~1 MB'lık strip'ler
+    uint32_t tileSize = 256;                // 16'nın katı olmalı
+    int deflateLevel = 6;
+    int zstdLevel = 9;
+    BigTiffMode bigTiff = BigTiffMode::Auto;
+    bool planar = false;                    // PLANARCONFIG_SEPARATE: C, M, Y, K ayrı düzlemler
+    unsigned threads = 0;                   // sıkıştırma thread'leri, 0 = donanım
+    // Tile'lı, yarıya inen çözünürlük seviyeleri (ek IFD'ler). Seri kodek
+    // (LZW) istenmişse ve zlib varsa Deflate kullanılır; bkz. TiffWriter.
+    bool pyramid = false;
+    uint32_t pyramidLevels = 0;             // ana görüntü hariç; 0 = en küçüğü tek tile'a sığana kadar
+};
+
+// 16-bit CMYK TIFF yazıcı. Satırlar blockRows() yüksekliğinde bloklar halinde
+// verilir; her blok bir veya daha fazla strip ya da bir sıra tile olur.
+//
+// Deflate (zlib ile derlendiyse), ZSTD (libzstd ile derlendiyse) ve
+// sıkıştırmasız çıktıda strip/tile'lar writer'ın thread havuzunda paralel
+// sıkıştırılıp TIFFWriteRawStrip/TIFFWriteRawTile ile sırayla yazılır. LZW ve
+// kütüphanesi bulunmayan kodekler libtiff'in kendi (seri) kodlayıcısına düşer.
+//
+// options.pyramid ile ana görüntü tile'lı yazılır ve yazılan satırlar aynı
+// geçişte 2x2 kutu filtresiyle küçültülerek alt seviyeler üretilir; görüntü
+// tekrar okunmaz. Alt seviyelerin tile'ları hazır oldukça sıkıştırılıp
+// bellekte tutulur ve close'da ana görüntüden sonra FILETYPE_REDUCEDIMAGE
+// dizinleri olarak sırayla yazılır. Seri kodek tile'ları belleğe kodlayamaz;
+// ham seviyeler ana görüntünün üçte biri kadar yer tutacağı için piramitte
+// LZW yerine paralel Deflate seçilir (zlib yoksa seviyeler ham bekler).
+// Görüntüleyici yakınlaştırmaya uyan dizinden yalnızca görünen tile'ları
+// okuyabilir.
+class TiffWriter {
+public:
+    TiffWriter();
+    ~TiffWriter();
+
+    TiffWriter(const TiffWriter&) = delete;
+    TiffWriter& operator=(const TiffWriter&) = delete;
+
+    bool open(const std::string& path, uint32_t width, uint32_t height,
+              const std::vector<uint8_t>& iccProfile, const TiffWriteOptions& options);
+
+    // writeRows'a verilen satır sayısı bunun katı olmalı (son blok hariç)
+    uint32_t blockRows() const { return rowsPerBlock; }
+
+    // firstRow'dan başlayan rows satırlık, satır satır bitişik CMYK16 veri.
+    // Yazma sırasında veri değiştirilmez.
+    bool writeRows(uint32_t firstRow, uint32_t rows, const CMYK16* pixels);
+
+    // encoded: blok başına (bant bant, bant içinde soldan sağa) hazır veri ya
+    // da nullptr. Hazır bloklar sıkıştırılmadan yazılır, pikselleri okunmaz;
+    // diğerleri her zamanki gibi kodlanır ve blockData ile alınabilir. Paralel
+    // kodekte veri sıkıştırılmış blok, seri kodekte (LZW) kodlanmamış dolgulu
+    // bloktur. Piramitle kullanılamaz.
+    bool writeRows(uint32_t firstRow, uint32_t rows, const CMYK16* pixels,
+                   const std::vector<uint8_t>* const* encoded);
+
+    // encoded ile yapılan son writeRows'ta j. bloğun yazılan verisi
+    // (yalnızca hazır verilmeyen bloklar için geçerli)
+    const std::vector<uint8_t>& blockData(size_t j) const { return compressed[j]; }
+
+    // options.planar ile açıldıysa: her düzlem rows * width uint16_t
+    bool writePlanes(uint32_t firstRow, uint32_t rows, const CMYKPlanes& planes);
+
+    // Bekleyen piramit seviyelerini yazıp dosyayı kapatır
+    bool close();
+
+    // Piramit seviyelerini yazmadan kapatır (yarım kalan dönüşümlerde)
+    void discard();
+
+    // Ana görüntünün altındaki seviye sayısı
+    uint32_t pyramidLevels() const { return static_cast<uint32_t>(levels.size()); }
+
+    // Sıkıştırma sonrası dosyaya giden veri (başlık ve dizinler hariç)
+    uint64_t compressedBytes() const { return written; }
+    bool isBigTiff() const { return bigTiff; }
+    bool isParallel() const { return parallel; }
+
+private:
+    // Piramidin bir seviyesi: üst seviyenin satırları ikişer ikişer gelir,
+    // bir tile yüksekliği dolunca band tile'lara bölünür
+    struct PyramidLevel {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t sourceWidth = 0;
+        uint32_t sourceHeight = 0;
+        uint32_t sourceRows = 0;                 // alınan üst seviye satırı
+        uint32_t rows = 0;                       // üretilen satır
+        std::vector<uint16_t> pending;           // eşini bekleyen üst seviye satırı
+        std::vector<uint16_t> band;              // tileSize satır, bitişik CMYK16
+        std::vector<std::vector<uint8_t>> tiles; // tile dizini sırasıyla
+    };
+
+    void setupDirectory(uint32_t directoryWidth, uint32_t directoryHeight, bool planarConfig);
+
+    // Ana görüntünün bitişik bir satırını piramide verir
+    bool addLevelRow(size_t level, const uint16_t* row);
+    bool flushLevelBand(PyramidLevel& level);
+    bool writeLevels();
+
+    // sources: planeCount düzlem, piksel başına samples örnek
+    bool writeBlocks(uint32_t firstRow, uint32_t rows, const uint16_t* const* sources,
+                     uint32_t planeCount, uint32_t samples,
+                     const std::vector<uint8_t>* const* encoded = nullptr);
+
+    bool compressBlock(const uint16_t* source, size_t sourceStride, uint32_t samples,
+                       uint32_t columns, uint32_t rows,
+                       uint32_t blockWidth, uint32_t blockHeight,
+                       std::vector<uint16_t>& scratch, std::vector<uint8_t>& out) const;
+
+    tiff* tif;
+    TiffWriteOptions options;
+    uint32_t width;
+    uint32_t height;
+    uint32_t rowsPerBlock;
+    bool parallel;
+    bool bigTiff;
+    uint64_t written;
+    std::unique_ptr<ThreadPool> pool;
+    std::vector<std::vector<uint8_t>> compressed;   // blok başına, çağrılar arasında tekrar kullanılır
+    std::vector<uint16_t> serialScratch;
+    std::vector<PyramidLevel> levels;
+    std::vector<uint16_t> interleaved;              // writePlanes'in piramide giden satırı
+};
+
+// Derlemede bulunan kodeğe göre paralel sıkıştırma mümkün mü
+bool tiffCompressionIsParallel(TiffCompression compression);
+
+#endif // TIFF_WRITER_HPP
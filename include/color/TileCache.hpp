@@ -0,0 +1,126 @@
+#ifndef TILE_CACHE_HPP
+#define TILE_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 64-bit xxHash (XXH64); parça parça beslenebilir
+class XxHash64 {
+public:
+    explicit XxHash64(uint64_t seed = 0);
+
+    void update(const void* data, size_t size);
+    uint64_t digest() const;
+
+    static uint64_t hash(const void* data, size_t size, uint64_t seed = 0);
+
+private:
+    uint64_t lanes[4];
+    uint64_t seed;
+    uint64_t total;
+    uint8_t buffer[32];
+    size_t buffered;
+};
+
+// Tile'ı tanımlayan iki özet: girdi piksellerinin içeriği ve çıktıyı
+// belirleyen her şey (profiller, intent, bayraklar, kodek, tile boyutu)
+struct TileKey {
+    uint64_t content = 0;
+    uint64_t context = 0;
+
+    bool operator==(const TileKey& other) const {
+        return content == other.content && context == other.context;
+    }
+};
+
+struct TileKeyHash {
+    size_t operator()(const TileKey& key) const {
+        return static_cast<size_t>(key.content ^ (key.context * 0x9E3779B97F4A7C15ull));
+    }
+};
+
+struct TileCacheOptions {
+    size_t memoryBytes = 256u * 1024 * 1024;    // bellek LRU üst sınırı
+    std::string directory;                      // boşsa yalnızca bellek
+    uint64_t diskBytes = 2ull * 1024 * 1024 * 1024; // disk LRU üst sınırı
+};
+
+struct TileCacheStats {
+    size_t memoryHits = 0;
+    size_t diskHits = 0;
+    size_t misses = 0;
+    size_t stores = 0;
+    size_t evictions = 0;        // bellekten ve diskten çıkarılan
+    size_t memoryBytes = 0;
+    uint64_t diskBytes = 0;
+};
+
+// Dönüştürülmüş ve kodlanmış çıktı tile'larının içerik adresli cache'i.
+// Aynı girdi tile'ı aynı ayarlarla tekrar geldiğinde (küçük bir düzenlemeden
+// sonra yeniden dışa aktarılan görüntü, görüntü içinde tekrar eden düz alanlar)
+// dönüşüm ve sıkıştırma atlanır, kayıtlı baytlar doğrudan TIFF'e yazılır.
+//
+// İki katman: bellekte boyutla sınırlı LRU, isteğe bağlı olarak dizinde
+// boyutla sınırlı LRU (erişim zamanı dosyanın değiştirilme zamanıyla
+// taşınır, süreçler arası korunur). Diskteki dosyalar başlıktaki anahtarla
+// doğrulanır, yazma geçici dosya + yeniden adlandırmayla yapılır.
+//
+// Thread-safe'tir; birden çok ImageColorConverter ve iş aynı cache'i paylaşabilir.
+class TileCache {
+public:
+    using Tile = std::shared_ptr<const std::vector<uint8_t>>;
+
+    static constexpr uint32_t kFormatVersion = 1;
+
+    explicit TileCache(const TileCacheOptions& options = TileCacheOptions());
+
+    // Önce bellek, sonra disk (bulunursa belleğe alınır); yoksa nullptr
+    Tile find(const TileKey& key);
+
+    // Belleğe ve dizin verildiyse diske yazar
+    void store(const TileKey& key, std::vector<uint8_t> data);
+
+    // Yalnızca bellek katmanını boşaltır
+    void clearMemory();
+
+    TileCacheStats stats() const;
+    const TileCacheOptions& getOptions() const { return options; }
+
+private:
+    struct MemoryEntry {
+        TileKey key;
+        Tile data;
+    };
+    struct DiskEntry {
+        TileKey key;
+        uint64_t size;
+    };
+
+    std::string pathFor(const TileKey& key) const;
+    void insertMemory(const TileKey& key, const Tile& tile);
+    // Dizindeki dosyaları ilk erişimde değiştirilme sırasıyla dizinler.
+    // mutex tutulmadan çağrılır; tarama kilit dışında, birleştirme altında.
+    void indexDisk();
+    // mutex tutulurken çağrılır; dizinden çıkarılan dosyaların yollarını
+    // döner, çağıran bunları kilidi bıraktıktan sonra siler
+    std::vector<std::string> trimDisk();
+
+    TileCacheOptions options;
+    mutable std::mutex mutex;
+    std::list<MemoryEntry> memoryOrder;          // baş: en son kullanılan
+    std::unordered_map<TileKey, std::list<MemoryEntry>::iterator, TileKeyHash> memory;
+    size_t memoryUsed;
+    std::list<DiskEntry> diskOrder;
+    std::unordered_map<TileKey, std::list<DiskEntry>::iterator, TileKeyHash> disk;
+    uint64_t diskUsed;
+    bool diskIndexed;
+    TileCacheStats counters;
+};
+
+#endif // TILE_CACHE_HPP
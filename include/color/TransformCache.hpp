@@ -0,0 +1,115 @@
+#ifndef TRANSFORM_CACHE_HPP
+#define TRANSFORM_CACHE_HPP
+
+#include <lcms2.h>
+#include <array>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// Transform'u çalıştıran motor: düz lcms2 veya lcms2 fast_float eklentisi
+enum class TransformEngine {
+    Lcms,
+    FastFloat,
+    Lut          // önceden hesaplanmış 3D LUT (Lut3D)
+};
+
+inline const char* engineName(TransformEngine engine) {
+    switch (engine) {
+        case TransformEngine::FastFloat: return "fast_float";
+        case TransformEngine::Lut:       return "lut3d";
+        default:                         return "lcms2";
+    }
+}
+
+// ICC profilinin MD5 özeti (profil başlığındaki Profile ID)
+using ProfileId = std::array<uint8_t, 16>;
+
+// Profilin serileştirilmiş (ICC dosyası) hali; salt okunur paylaşılır
+using ProfileData = std::shared_ptr<const std::vector<uint8_t>>;
+
+// Paylaşılan, açık bir ICC profili. TransformCache de bir referans tuttuğu
+// için cache'ten açılan profiller clear() çağrılana kadar açık kalır; sonra
+// son kullanıcı bıraktığında kapanır.
+// data, profilin açıldığı baytlardır; TIFF'e gömmek için tekrar
+// serileştirmeye gerek kalmaz.
+struct CachedProfile {
+    std::shared_ptr<void> handle;
+    ProfileId id{};
+    ProfileData data;
+
+    cmsHPROFILE get() const { return handle.get(); }
+    explicit operator bool() const { return handle != nullptr; }
+};
+
+// Süreç genelinde, thread-safe profil ve transform cache'i.
+// Transform'lar (profil özeti, piksel formatları, intent, flag) ile anahtarlanır;
+// aynı profil çiftini kullanan tüm converter'lar tek bir transform'u paylaşır.
+// Paylaşılan transform'lar aynı anda birden çok thread'den kullanılacağı için
+// istenen bayraklara her zaman cmsFLAGS_NOCACHE eklenir.
+//
+// lcms2_fast_float ile derlendiyse (COLOR_HAVE_FAST_FLOAT) eklenti ayrı bir
+// lcms context'ine kaydedilir; allowFastFloat ile istenen transform'lar o
+// context'te oluşturulur. Eklenti formatı desteklemezse lcms2 kendi yoluna
+// düşer; hangi motorun seçildiği engineOf ile sorgulanır.
+class TransformCache {
+public:
+    struct Stats {
+        size_t profileHits = 0;
+        size_t profileMisses = 0;
+        size_t transformHits = 0;
+        size_t transformMisses = 0;
+    };
+
+    static TransformCache& instance();
+
+    // Dosya yolu + boyut + değiştirilme zamanı aynıysa diske gidilmez
+    CachedProfile openProfile(const std::string& path);
+
+    // Bellekteki profil (ör. programa gömülü kaynak). Baytlar kopyalanır;
+    // aynı içerik daha önce açıldıysa mevcut handle döner.
+    CachedProfile openProfileFromMemory(const void* data, size_t size);
+
+    std::shared_ptr<void> getTransform(const CachedProfile& input, cmsUInt32Number inputFormat,
+                                       const CachedProfile& output, cmsUInt32Number outputFormat,
+                                       cmsUInt32Number intent, cmsUInt32Number flags,
+                                       bool allowFastFloat = true);
+
+    // Eklenti bu derlemede mevcut ve kaydedilebildi mi
+    static bool fastFloatAvailable();
+
+    // Transform'u eklentinin mi yoksa lcms2'nin mi çalıştırdığı
+    static TransformEngine engineOf(cmsHTRANSFORM transform);
+
+    Stats stats() const;
+    // Cache'in profil ve transform referanslarını bırakır; kullanımdakiler
+    // son sahipleri bırakana kadar geçerli kalır
+    void clear();
+
+private:
+    TransformCache() = default;
+
+    // Baytlardan profili açar ve özetine göre tekilleştirir
+    CachedProfile adopt(ProfileData bytes);
+
+    struct FileEntry {
+        uintmax_t size;
+        int64_t mtime;
+        CachedProfile profile;
+    };
+    using TransformKey = std::tuple<ProfileId, cmsUInt32Number, ProfileId, cmsUInt32Number,
+                                    cmsUInt32Number, cmsUInt32Number, bool>;
+
+    mutable std::mutex mutex;       // map'leri korur
+    std::mutex buildMutex;          // pahalı transform oluşturmayı tekilleştirir
+    std::map<std::string, FileEntry> files;
+    std::map<ProfileId, CachedProfile> profiles;
+    std::map<TransformKey, std::shared_ptr<void>> transforms;
+    Stats counters;
+};
+
+#endif // TRANSFORM_CACHE_HPP
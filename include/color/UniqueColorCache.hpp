@@ -0,0 +1,62 @@
+#ifndef UNIQUE_COLOR_CACHE_HPP
+#define UNIQUE_COLOR_CACHE_HPP
+
+#include "color/ColorTypes.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Az sayıda farklı renkten oluşan görüntüler (logo, ekran görüntüsü, vektör
+// çizim) için: her farklı RGB değeri bir kez dönüştürülür, sonuç tüm
+// piksellere dağıtılır.
+//
+// Renkler açık adreslemeli bir tabloda tutulur; her yuva tek bir 64-bit
+// kelimedir (üst 48 bit paketlenmiş RGB, alt 16 bit sonuç indeksi), böylece
+// 64K renkli tablo bile 1 MB'ı geçmez. Pikseller blok blok işlenir: bloktaki
+// yeni renkler tek bir çağrıyla dönüştürülür, ardından blok yazılır.
+class UniqueColorCache {
+public:
+    // Dönüştürülmüş renkleri toplu dönüştüren geri çağrı (girdi/çıktı sıkışık)
+    using BatchConvert = std::function<void(const uint8_t* input, uint8_t* output, size_t pixelCount)>;
+
+    // 16-bit indeksin en büyük değeri boş yuva işaretine ayrılmıştır
+    static constexpr size_t kMaxColors = 0xFFFF;
+
+    // maxColors en fazla kMaxColors; expectedPixels tablo boyutunu küçük
+    // girdiler için sınırlar
+    UniqueColorCache(PixelFormat inputFormat, PixelFormat outputFormat,
+                     size_t maxColors, size_t expectedPixels);
+
+    // Eşit aralıklı örneklerdeki tekrarlardan toplam renk sayısını tahmin
+    // eder; tahmin maxColors'a sığıyor ve her renk ortalama birçok pikselde
+    // geçiyorsa true. Yüksek kardinaliteli girdiyi tabloyu kurmadan eler.
+    static bool looksFlat(const void* input, PixelFormat inputFormat, size_t pixelCount,
+                          size_t maxColors);
+
+    // Baştan itibaren dönüştürülen piksel sayısını döner. Renk sayısı sınırı
+    // aşılırsa durur (dönen değer < pixelCount) ve kalan pikseller çağırana
+    // kalır; bu noktadan sonra cache kullanılmaz.
+    size_t convert(const void* input, void* output, size_t pixelCount, const BatchConvert& batch);
+
+    size_t uniqueColors() const { return colorCount; }
+
+private:
+    uint64_t keyOf(const uint8_t* pixel) const;
+
+    PixelFormat inFormat;
+    size_t inPixel;
+    size_t outPixel;
+    size_t limit;
+    size_t colorCount;
+    bool full;
+
+    unsigned shift;                 // 64 - log2(yuva sayısı)
+    std::vector<uint64_t> slots;
+    std::vector<uint8_t> results;   // colorCount * outPixel, indeks sırasıyla
+
+    std::vector<uint8_t> pending;   // bloktaki yeni renklerin girdi pikselleri
+    std::vector<uint16_t> indices;  // bloktaki her pikselin sonuç indeksi
+};
+
+#endif // UNIQUE_COLOR_CACHE_HPP
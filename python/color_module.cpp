@@ -0,0 +1,590 @@
+// color_converter kütüphanesinin CPython eklentisi.
+//
+//   import color_converter as cc
+//   converter = cc.Converter("sRGB.icc", "output_CMYK.icc", threads=0)
+//   cmyk = np.asarray(converter.convert(rgb))          # (h, w, 4) uint16
+//   converter.convert(rgb, out=cmyk8)                  # var olan buffer'a
+//
+// Diziler buffer protokolüyle alınır ve verilir; girdi kopyalanmaz, çıktı
+// tek bir buffer'a doğrudan yazılır ve numpy'a kopyasız görünür. Dönüşüm
+// sırasında GIL bırakılır, böylece aynı Converter'ı paylaşan Python
+// thread'leri paralel çalışır (ColorConverter const ve thread-safe'tir).
+// numpy derleme zamanında gerekmez. Türler PyType_FromModuleAndSpec ile
+// değişmez heap türleri olarak kurulur (Python 3.10+).
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include "color/ColorConverter.hpp"
+#include "color/ImageColorConverter.hpp"
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+
+namespace {
+    // --- Modül durumu ------------------------------------------------------------
+
+    // Converter metotları _Pixels türüne kendi türlerinin modülünden ulaşır
+    struct ModuleState {
+        PyObject* pixelsType;
+    };
+
+    ModuleState* stateOf(PyObject* module) {
+        return static_cast<ModuleState*>(PyModule_GetState(module));
+    }
+
+    ModuleState* stateOf(PyTypeObject* type) {
+        return static_cast<ModuleState*>(PyType_GetModuleState(type));
+    }
+
+    // --- Çıktı piksel buffer'ı -------------------------------------------------
+
+    // convert'in ayırdığı çıktı; memoryview olarak döner, (h, w, 4) şeklinde
+    struct PixelsObject {
+        PyObject_HEAD
+        uint8_t* data;
+        Py_ssize_t shape[3];
+        Py_ssize_t strides[3];
+        int ndim;
+        Py_ssize_t itemsize;
+    };
+
+    // Heap türünün örnekleri türe referans tutar; dealloc bunu bırakır
+    void pixelsDealloc(PyObject* self) {
+        PyTypeObject* type = Py_TYPE(self);
+        delete[] reinterpret_cast<PixelsObject*>(self)->data;
+        type->tp_free(self);
+        Py_DECREF(type);
+    }
+
+    int pixelsGetBuffer(PyObject* self, Py_buffer* view, int flags) {
+        PixelsObject* pixels = reinterpret_cast<PixelsObject*>(self);
+        Py_ssize_t length = pixels->itemsize;
+        for (int i = 0; i < pixels->ndim; ++i) length *= pixels->shape[i];
+
+        view->obj = self;
+        Py_INCREF(self);
+        view->buf = pixels->data;
+        view->len = length;
+        view->readonly = 0;
+        view->itemsize = pixels->itemsize;
+        view->format = (flags & PyBUF_FORMAT) ? const_cast<char*>(pixels->itemsize == 2 ? "H" : "B") : nullptr;
+        view->ndim = (flags & PyBUF_ND) ? pixels->ndim : 1;
+        view->shape = (flags & PyBUF_ND) ? pixels->shape : nullptr;
+        view->strides = (flags & PyBUF_STRIDES) ? pixels->strides : nullptr;
+        view->suboffsets = nullptr;
+        view->internal = nullptr;
+        return 0;
+    }
+
+    PyType_Slot pixelsSlots[] = {
+        {Py_tp_dealloc, reinterpret_cast<void*>(pixelsDealloc)},
+        {Py_bf_getbuffer, reinterpret_cast<void*>(pixelsGetBuffer)},
+        {Py_tp_doc, const_cast<char*>("Pixel buffer owned by a conversion result")},
+        {0, nullptr}};
+
+    // Python'dan oluşturulamaz; yalnızca convert üretir
+    PyType_Spec pixelsSpec = {
+        "color_converter._Pixels", sizeof(PixelsObject), 0,
+        Py_TPFLAGS_DEFAULT | Py_TPFLAGS_IMMUTABLETYPE | Py_TPFLAGS_DISALLOW_INSTANTIATION, pixelsSlots};
+
+    // shape belleğin düzenidir: (h, w, 4) veya (n, 4). _Pixels türü owner'ın
+    // (Converter) türünün modülünden alınır.
+    PyObject* newPixels(PyObject* owner, int ndim, const Py_ssize_t* shape, Py_ssize_t itemsize) {
+        Py_ssize_t length = itemsize;
+        for (int i = 0; i < ndim; ++i) length *= shape[i];
+
+        ModuleState* state = stateOf(Py_TYPE(owner));
+        if (!state) return nullptr;
+        PixelsObject* pixels = PyObject_New(PixelsObject, reinterpret_cast<PyTypeObject*>(state->pixelsType));
+        if (!pixels) return nullptr;
+        // Sıfırlanmaz; dönüşüm her baytı yazar
+        pixels->data = new (std::nothrow) uint8_t[length ? length : 1];
+        if (!pixels->data) {
+            Py_DECREF(pixels);
+            return PyErr_NoMemory();
+        }
+        pixels->ndim = ndim;
+        pixels->itemsize = itemsize;
+        Py_ssize_t stride = itemsize;
+        for (int i = ndim - 1; i >= 0; --i) {
+            pixels->shape[i] = shape[i];
+            pixels->strides[i] = stride;
+            stride *= shape[i];
+        }
+        return reinterpret_cast<PyObject*>(pixels);
+    }
+
+    // --- Buffer çözümleme ------------------------------------------------------
+
+    // Py_buffer'ı çağrı sonunda bırakır
+    struct BufferGuard {
+        Py_buffer view{};
+        bool held = false;
+        ~BufferGuard() {
+            if (held) PyBuffer_Release(&view);
+        }
+    };
+
+    // "B", "<H", "=H" ... -> örnek boyutu; desteklenmiyorsa 0
+    Py_ssize_t sampleSize(const Py_buffer& view) {
+        const char* format = view.format ? view.format : "B";
+        if (*format == '@' || *format == '=' || *format == '<' || *format == '!' || *format == '>') {
+            // Yalnızca makinenin bayt sırası
+            const bool little = PY_LITTLE_ENDIAN;
+            if ((*format == '>' || *format == '!') && little) return 0;
+            if (*format == '<' && !little) return 0;
+            ++format;
+        }
+        if (std::strcmp(format, "B") == 0 || std::strcmp(format, "c") == 0) return view.itemsize == 1 ? 1 : 0;
+        if (std::strcmp(format, "H") == 0) return view.itemsize == 2 ? 2 : 0;
+        return 0;
+    }
+
+    bool parseFormat(const char* name, PixelFormat& format) {
+        static const struct { const char* name; PixelFormat format; } names[] = {
+            {"RGB8", PixelFormat::RGB8}, {"RGBA8", PixelFormat::RGBA8}, {"RGB16", PixelFormat::RGB16},
+            {"CMYK8", PixelFormat::CMYK8}, {"CMYK16", PixelFormat::CMYK16}};
+        for (const auto& entry : names) {
+            if (std::strcmp(name, entry.name) == 0) {
+                format = entry.format;
+                return true;
+            }
+        }
+        PyErr_Format(PyExc_ValueError, "unknown pixel format '%s'", name);
+        return false;
+    }
+
+    // Bellekteki görüntü: satırlar rowStride bayt arayla, satır içi pikseller bitişik
+    struct Image {
+        Py_buffer* view = nullptr;
+        PixelFormat format = PixelFormat::RGB8;
+        size_t width = 0;
+        size_t height = 0;
+        size_t rowStride = 0;
+    };
+
+    // (h, w, c), (n, c) veya formatı verilmiş düz buffer. Satırlar arası
+    // aralık serbest (ör. büyük dizinin dilimi), satır içi bitişik olmalı.
+    bool describe(Py_buffer& view, const char* formatName, bool rgb, Image& image) {
+        const Py_ssize_t sample = sampleSize(view);
+        if (sample == 0) {
+            PyErr_SetString(PyExc_TypeError, "buffer must hold uint8 or native-endian uint16 samples");
+            return false;
+        }
+
+        if (formatName) {
+            if (!parseFormat(formatName, image.format)) return false;
+            const bool rgbFormat = image.format == PixelFormat::RGB8 || image.format == PixelFormat::RGBA8 ||
+                                   image.format == PixelFormat::RGB16;
+            if (rgbFormat != rgb) {
+                PyErr_SetString(PyExc_ValueError, rgb ? "input format must be RGB8, RGBA8 or RGB16"
+                                                      : "output format must be CMYK8 or CMYK16");
+                return false;
+            }
+            if (!PyBuffer_IsContiguous(&view, 'C')) {
+                PyErr_SetString(PyExc_ValueError, "buffer with an explicit format must be C-contiguous");
+                return false;
+            }
+            const size_t pixel = bytesPerPixel(image.format);
+            if (view.len % pixel != 0) {
+                PyErr_SetString(PyExc_ValueError, "buffer size is not a whole number of pixels");
+                return false;
+            }
+            image.width = static_cast<size_t>(view.len) / pixel;
+            image.height = image.width ? 1 : 0;
+            image.rowStride = static_cast<size_t>(view.len);
+        } else {
+            if (view.ndim != 2 && view.ndim != 3) {
+                PyErr_SetString(PyExc_ValueError, "expected an (h, w, c) or (n, c) array, or pass a format");
+                return false;
+            }
+            const Py_ssize_t channels = view.shape[view.ndim - 1];
+            if (rgb) {
+                if (channels == 3) image.format = sample == 1 ? PixelFormat::RGB8 : PixelFormat::RGB16;
+                else if (channels == 4 && sample == 1) image.format = PixelFormat::RGBA8;
+                else {
+                    PyErr_SetString(PyExc_ValueError, "input must be RGB8, RGBA8 or RGB16 (last axis 3 or 4)");
+                    return false;
+                }
+            } else {
+                if (channels != 4) {
+                    PyErr_SetString(PyExc_ValueError, "output must have 4 channels (CMYK)");
+                    return false;
+                }
+                image.format = sample == 1 ? PixelFormat::CMYK8 : PixelFormat::CMYK16;
+            }
+
+            const Py_ssize_t pixel = channels * sample;
+            const Py_ssize_t* strides = view.strides;
+            const bool packedPixels = !strides ||
+                (strides[view.ndim - 1] == sample && (view.ndim == 2 || strides[1] == pixel));
+            image.height = view.ndim == 3 ? static_cast<size_t>(view.shape[0]) : 1;
+            image.width = view.ndim == 3 ? static_cast<size_t>(view.shape[1]) : static_cast<size_t>(view.shape[0]);
+            const size_t rowBytes = image.width * static_cast<size_t>(pixel);
+            image.rowStride = rowBytes;
+            if (!packedPixels || (view.ndim == 2 && strides && strides[0] != pixel)) {
+                PyErr_SetString(PyExc_ValueError, "pixels within a row must be contiguous");
+                return false;
+            }
+            if (view.ndim == 3 && strides && image.height > 1) {
+                // 0 (np.broadcast_to) ve satırdan kısa aralıklar satırları üst üste
+                // bindirir; ColorConverter 0'ı sıkışık sayar ve buffer dışına taşar
+                if (strides[0] < 0 || static_cast<size_t>(strides[0]) < rowBytes) {
+                    PyErr_SetString(PyExc_ValueError, "row stride must be at least width * pixel size");
+                    return false;
+                }
+                image.rowStride = static_cast<size_t>(strides[0]);
+            }
+        }
+        image.view = &view;
+        return true;
+    }
+
+    // --- Converter ---------------------------------------------------------------
+
+    // converter yalnızca GIL tutulurken değiştirilir; convert çağrıları GIL'i
+    // bırakmadan önce bir kopyasını alır, böylece __init__ tekrar çağrılsa da
+    // süren dönüşümün converter'ı yaşar
+    struct ConverterObject {
+        PyObject_HEAD
+        std::shared_ptr<const ColorConverter> converter;
+    };
+
+    void converterDealloc(PyObject* self) {
+        PyTypeObject* type = Py_TYPE(self);
+        reinterpret_cast<ConverterObject*>(self)->converter.~shared_ptr();
+        type->tp_free(self);
+        Py_DECREF(type);
+    }
+
+    PyObject* converterNew(PyTypeObject* type, PyObject*, PyObject*) {
+        ConverterObject* self = reinterpret_cast<ConverterObject*>(type->tp_alloc(type, 0));
+        if (self) new (&self->converter) std::shared_ptr<const ColorConverter>();
+        return reinterpret_cast<PyObject*>(self);
+    }
+
+    int converterInit(PyObject* object, PyObject* args, PyObject* kwargs) {
+        static const char* keywords[] = {"rgb_profile", "cmyk_profile", "intent", "lut_grid",
+                                         "threads", "unique_colors", nullptr};
+        const char* rgbProfile = nullptr;
+        const char* cmykProfile = nullptr;
+        unsigned intent = INTENT_PERCEPTUAL, lutGrid = 0, threads = 1;
+        Py_ssize_t uniqueColors = 0;
+        if (!PyArg_ParseTupleAndKeywords(args, kwargs, "ss|$IIIn", const_cast<char**>(keywords),
+                                         &rgbProfile, &cmykProfile, &intent, &lutGrid, &threads,
+                                         &uniqueColors)) {
+            return -1;
+        }
+
+        ConversionOptions options;
+        options.intent = intent;
+        options.lutGridPoints = lutGrid;
+        options.uniqueColorLimit = static_cast<size_t>(uniqueColors > 0 ? uniqueColors : 0);
+
+        std::unique_ptr<ColorConverter> converter(new ColorConverter());
+        bool ok;
+        Py_BEGIN_ALLOW_THREADS
+        ok = converter->initialize(rgbProfile, cmykProfile, options);
+        if (ok) converter->setThreadCount(threads);
+        Py_END_ALLOW_THREADS
+        if (!ok) {
+            PyErr_Format(PyExc_RuntimeError, "failed to create transform from '%s' and '%s'",
+                         rgbProfile, cmykProfile);
+            return -1;
+        }
+
+        reinterpret_cast<ConverterObject*>(object)->converter = std::move(converter);
+        return 0;
+    }
+
+    PyObject* converterConvert(PyObject* object, PyObject* args, PyObject* kwargs) {
+        static const char* keywords[] = {"pixels", "depth", "out", "format", nullptr};
+        PyObject* source = nullptr;
+        PyObject* target = Py_None;
+        int depth = 16;
+        const char* formatName = nullptr;
+        if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|$iOz", const_cast<char**>(keywords),
+                                         &source, &depth, &target, &formatName)) {
+            return nullptr;
+        }
+        const std::shared_ptr<const ColorConverter> converter = reinterpret_cast<ConverterObject*>(object)->converter;
+        if (!converter) {
+            PyErr_SetString(PyExc_RuntimeError, "converter is not initialized");
+            return nullptr;
+        }
+        if (depth != 8 && depth != 16) {
+            PyErr_SetString(PyExc_ValueError, "depth must be 8 or 16");
+            return nullptr;
+        }
+
+        BufferGuard input;
+        if (PyObject_GetBuffer(source, &input.view, PyBUF_RECORDS_RO) != 0) return nullptr;
+        input.held = true;
+        Image in;
+        if (!describe(input.view, formatName, true, in)) return nullptr;
+
+        // Çıktı: verilen yazılabilir buffer ya da girdiyle aynı şekilde yeni bir dizi
+        PyObject* result = nullptr;
+        BufferGuard output;
+        if (target != Py_None) {
+            result = target;
+            Py_INCREF(result);
+        } else {
+            const Py_ssize_t itemsize = depth == 16 ? 2 : 1;
+            Py_ssize_t shape[3];
+            int ndim;
+            if (input.view.ndim == 3 && !formatName) {
+                shape[0] = input.view.shape[0];
+                shape[1] = input.view.shape[1];
+                ndim = 3;
+            } else {
+                shape[0] = static_cast<Py_ssize_t>(in.width * in.height);
+                ndim = 2;
+            }
+            shape[ndim - 1] = 4;
+            result = newPixels(object, ndim, shape, itemsize);
+            if (!result) return nullptr;
+        }
+        std::unique_ptr<PyObject, void (*)(PyObject*)> owned(result, [](PyObject* o) { Py_XDECREF(o); });
+
+        if (PyObject_GetBuffer(result, &output.view, PyBUF_RECORDS) != 0) return nullptr;
+        output.held = true;
+        Image out;
+        if (!describe(output.view, nullptr, false, out)) return nullptr;
+        if (out.width * out.height != in.width * in.height ||
+            (out.height != in.height && out.height != 1 && in.height != 1)) {
+            PyErr_SetString(PyExc_ValueError, "output shape does not match input");
+            return nullptr;
+        }
+
+        // Tek satırlı tarafı diğerinin satır düzenine aç
+        size_t width = in.width, height = in.height;
+        size_t inStride = in.rowStride, outStride = out.rowStride;
+        if (in.height == 1 && out.height != 1) {
+            width = out.width;
+            height = out.height;
+            inStride = width * bytesPerPixel(in.format);
+        } else if (out.height == 1 && in.height != 1) {
+            outStride = width * bytesPerPixel(out.format);
+        }
+
+        bool ok = true;
+        if (width && height) {
+            Py_BEGIN_ALLOW_THREADS
+            ok = converter->convert(in.view->buf, in.format, inStride,
+                                    out.view->buf, out.format, outStride, width, height);
+            Py_END_ALLOW_THREADS
+        }
+        if (!ok) {
+            PyErr_SetString(PyExc_RuntimeError, "color conversion failed");
+            return nullptr;
+        }
+
+        if (target != Py_None) return owned.release();
+        return PyMemoryView_FromObject(owned.get());
+    }
+
+    PyObject* converterEngine(PyObject* object, PyObject* args) {
+        const char* inputName = "RGB8";
+        const char* outputName = "CMYK16";
+        if (!PyArg_ParseTuple(args, "|ss", &inputName, &outputName)) return nullptr;
+        const std::shared_ptr<const ColorConverter> converter = reinterpret_cast<ConverterObject*>(object)->converter;
+        PixelFormat input, output;
+        if (!converter || !parseFormat(inputName, input) || !parseFormat(outputName, output)) {
+            if (!PyErr_Occurred()) PyErr_SetString(PyExc_RuntimeError, "converter is not initialized");
+            return nullptr;
+        }
+        return PyUnicode_FromString(engineName(converter->engine(input, output)));
+    }
+
+    PyMethodDef converterMethods[] = {
+        {"convert", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)(void)>(converterConvert)),
+         METH_VARARGS | METH_KEYWORDS,
+         "convert(pixels, *, depth=16, out=None, format=None)\n\n"
+         "Convert an RGB8/RGBA8/RGB16 buffer to CMYK. Returns a memoryview of a new\n"
+         "(h, w, 4) array, or writes into 'out' and returns it. The GIL is released."},
+        {"engine", converterEngine, METH_VARARGS,
+         "engine(input='RGB8', output='CMYK16') -> 'lcms2' | 'fast_float' | 'lut3d'"},
+        {nullptr, nullptr, 0, nullptr}};
+
+    PyType_Slot converterSlots[] = {
+        {Py_tp_dealloc, reinterpret_cast<void*>(converterDealloc)},
+        {Py_tp_new, reinterpret_cast<void*>(converterNew)},
+        {Py_tp_init, reinterpret_cast<void*>(converterInit)},
+        {Py_tp_methods, converterMethods},
+        {Py_tp_doc, const_cast<char*>(
+            "Converter(rgb_profile, cmyk_profile, *, intent=0, lut_grid=0, threads=1, unique_colors=0)\n\n"
+            "RGB -> CMYK pixel converter. Safe to share between threads.")},
+        {0, nullptr}};
+
+    PyType_Spec converterSpec = {
+        "color_converter.Converter", sizeof(ConverterObject), 0,
+        Py_TPFLAGS_DEFAULT | Py_TPFLAGS_IMMUTABLETYPE, converterSlots};
+
+    // --- ImageConverter ----------------------------------------------------------
+
+    // ImageColorConverter tek bir çağrıyı aynı anda işler; kilit, GIL
+    // bırakılmışken aynı nesneye gelen ikinci çağrıyı bekletir. converter
+    // Converter'daki gibi GIL altında değiştirilir ve çağrı başına kopyalanır.
+    struct ImageConverterObject {
+        PyObject_HEAD
+        std::shared_ptr<ImageColorConverter> converter;
+        std::mutex* mutex;
+    };
+
+    void imageConverterDealloc(PyObject* self) {
+        ImageConverterObject* image = reinterpret_cast<ImageConverterObject*>(self);
+        image->converter.~shared_ptr();
+        delete image->mutex;
+        PyTypeObject* type = Py_TYPE(self);
+        type->tp_free(self);
+        Py_DECREF(type);
+    }
+
+    PyObject* imageConverterNew(PyTypeObject* type, PyObject*, PyObject*) {
+        ImageConverterObject* self = reinterpret_cast<ImageConverterObject*>(type->tp_alloc(type, 0));
+        if (self) {
+            new (&self->converter) std::shared_ptr<ImageColorConverter>();
+            self->mutex = new std::mutex();
+        }
+        return reinterpret_cast<PyObject*>(self);
+    }
+
+    int imageConverterInit(PyObject* object, PyObject* args, PyObject* kwargs) {
+        static const char* keywords[] = {"rgb_profile", "cmyk_profile", "intent", "lut_grid",
+                                         "threads", "verbose", nullptr};
+        const char* rgbProfile = nullptr;
+        const char* cmykProfile = nullptr;
+        unsigned intent = INTENT_PERCEPTUAL, lutGrid = 0, threads = 0;
+        int verbose = 0;
+        if (!PyArg_ParseTupleAndKeywords(args, kwargs, "ss|$IIIp", const_cast<char**>(keywords),
+                                         &rgbProfile, &cmykProfile, &intent, &lutGrid, &threads,
+                                         &verbose)) {
+            return -1;
+        }
+
+        ConversionOptions options;
+        options.intent = intent;
+        options.lutGridPoints = lutGrid;
+
+        std::unique_ptr<ImageColorConverter> converter(new ImageColorConverter());
+        bool ok;
+        Py_BEGIN_ALLOW_THREADS
+        converter->setVerbose(verbose != 0);
+        ok = converter->initialize(rgbProfile, cmykProfile, options);
+        if (ok) converter->colorConverter().setThreadCount(threads);
+        Py_END_ALLOW_THREADS
+        if (!ok) {
+            PyErr_Format(PyExc_RuntimeError, "failed to create transform from '%s' and '%s'",
+                         rgbProfile, cmykProfile);
+            return -1;
+        }
+
+        reinterpret_cast<ImageConverterObject*>(object)->converter = std::move(converter);
+        return 0;
+    }
+
+    PyObject* imageConverterConvert(PyObject* object, PyObject* args) {
+        const char* inputPath = nullptr;
+        const char* outputPath = nullptr;
+        if (!PyArg_ParseTuple(args, "ss", &inputPath, &outputPath)) return nullptr;
+        ImageConverterObject* self = reinterpret_cast<ImageConverterObject*>(object);
+        const std::shared_ptr<ImageColorConverter> converter = self->converter;
+        if (!converter) {
+            PyErr_SetString(PyExc_RuntimeError, "converter is not initialized");
+            return nullptr;
+        }
+
+        bool ok;
+        std::string error;
+        Py_BEGIN_ALLOW_THREADS
+        {
+            std::lock_guard<std::mutex> lock(*self->mutex);
+            ok = converter->convertImage(inputPath, outputPath);
+            if (!ok) error = converter->lastError();
+        }
+        Py_END_ALLOW_THREADS
+        if (!ok) {
+            PyErr_Format(PyExc_RuntimeError, "failed to convert '%s': %s", inputPath, error.c_str());
+            return nullptr;
+        }
+        Py_RETURN_NONE;
+    }
+
+    PyMethodDef imageConverterMethods[] = {
+        {"convert", imageConverterConvert, METH_VARARGS,
+         "convert(input_path, output_path)\n\n"
+         "Decode, convert and write a CMYK TIFF with the output profile embedded.\n"
+         "The GIL is released for the whole pipeline."},
+        {nullptr, nullptr, 0, nullptr}};
+
+    PyType_Slot imageConverterSlots[] = {
+        {Py_tp_dealloc, reinterpret_cast<void*>(imageConverterDealloc)},
+        {Py_tp_new, reinterpret_cast<void*>(imageConverterNew)},
+        {Py_tp_init, reinterpret_cast<void*>(imageConverterInit)},
+        {Py_tp_methods, imageConverterMethods},
+        {Py_tp_doc, const_cast<char*>(
+            "ImageConverter(rgb_profile, cmyk_profile, *, intent=0, lut_grid=0, threads=0, verbose=False)\n\n"
+            "Image file -> CMYK TIFF pipeline.")},
+        {0, nullptr}};
+
+    PyType_Spec imageConverterSpec = {
+        "color_converter.ImageConverter", sizeof(ImageConverterObject), 0,
+        Py_TPFLAGS_DEFAULT | Py_TPFLAGS_IMMUTABLETYPE, imageConverterSlots};
+
+    // --- Modül -------------------------------------------------------------------
+
+    int moduleTraverse(PyObject* module, visitproc visit, void* arg) {
+        Py_VISIT(stateOf(module)->pixelsType);
+        return 0;
+    }
+
+    int moduleClear(PyObject* module) {
+        Py_CLEAR(stateOf(module)->pixelsType);
+        return 0;
+    }
+
+    void moduleFree(void* module) {
+        moduleClear(static_cast<PyObject*>(module));
+    }
+
+    PyModuleDef moduleDef = {
+        PyModuleDef_HEAD_INIT,
+        "color_converter",
+        "ICC based RGB -> CMYK conversion (lcms2) with zero-copy buffers",
+        sizeof(ModuleState),
+        nullptr,
+        nullptr,
+        moduleTraverse,
+        moduleClear,
+        moduleFree};
+
+    bool addType(PyObject* module, PyType_Spec& spec) {
+        PyObject* type = PyType_FromModuleAndSpec(module, &spec, nullptr);
+        if (!type) return false;
+        // PyModule_AddType kendi referansını alır
+        const int result = PyModule_AddType(module, reinterpret_cast<PyTypeObject*>(type));
+        Py_DECREF(type);
+        return result == 0;
+    }
+}
+
+PyMODINIT_FUNC PyInit_color_converter() {
+    PyObject* module = PyModule_Create(&moduleDef);
+    if (!module) return nullptr;
+    stateOf(module)->pixelsType = PyType_FromModuleAndSpec(module, &pixelsSpec, nullptr);
+    if (!stateOf(module)->pixelsType ||
+        !addType(module, converterSpec) ||
+        !addType(module, imageConverterSpec)) {
+        Py_DECREF(module);
+        return nullptr;
+    }
+    PyModule_AddIntConstant(module, "INTENT_PERCEPTUAL", INTENT_PERCEPTUAL);
+    PyModule_AddIntConstant(module, "INTENT_RELATIVE_COLORIMETRIC", INTENT_RELATIVE_COLORIMETRIC);
+    PyModule_AddIntConstant(module, "INTENT_SATURATION", INTENT_SATURATION);
+    PyModule_AddIntConstant(module, "INTENT_ABSOLUTE_COLORIMETRIC", INTENT_ABSOLUTE_COLORIMETRIC);
+    return module;
+}
@@ -1,15 +1,57 @@
 fn main() {
     tauri_build::build();
     
-    cxx_build::bridge("src/lib.rs")
+    // color_converter kütüphanesi (../src/color) köprüyle birlikte derlenir;
+    // CMake'teki GLOB gibi dizindeki tüm .cpp dosyaları alınır
+    let color_sources: Vec<_> = std::fs::read_dir("../src/color")
+        .expect("../src/color not found")
+        .filter_map(|entry| entry.ok().map(|e| e.path()))
+        .filter(|path| path.extension().map_or(false, |ext| ext == "cpp"))
+        .collect();
+
+    let mut build = cxx_build::bridge("src/lib.rs");
+    build
         .file("cpp/hello.cpp")
         .file("cpp/math_lib.cpp")
-        .flag_if_supported("-std=c++14")
-        .compile("hello-world");
+        .file("cpp/color_bridge.cpp")
+        .file("cpp/image_ops.cpp")
+        .files(&color_sources)
+        .include("../include")
+        .flag_if_supported("-std=c++17")
+        .flag_if_supported("/std:c++17");
+
+    // CMakeLists.txt'deki isteğe bağlı kütüphaneler: bulunanlar için aynı
+    // COLOR_HAVE_* tanımları hem kütüphaneye hem köprüye verilir, böylece
+    // ikisi aynı yapılandırmayla derlenir. pkg-config bağlama satırlarını da yazar.
+    let optional = [
+        ("zlib", "COLOR_HAVE_ZLIB"),
+        ("libzstd", "COLOR_HAVE_ZSTD"),
+        ("libpng", "COLOR_HAVE_PNG"),
+        ("libjpeg", "COLOR_HAVE_JPEG"),
+        ("lcms2_fast_float", "COLOR_HAVE_FAST_FLOAT"),
+    ];
+    for (package, define) in optional {
+        if let Ok(library) = pkg_config::Config::new().cargo_metadata(true).probe(package) {
+            build.define(define, None);
+            build.includes(&library.include_paths);
+        }
+    }
+
+    build.compile("hello-world");
+
+    // lcms2 ve libtiff sistemden bağlanır (Windows'ta MSYS2 mingw paketleri)
+    println!("cargo:rustc-link-lib=lcms2");
+    println!("cargo:rustc-link-lib=tiff");
         
     println!("cargo:rerun-if-changed=cpp/hello.cpp");
     println!("cargo:rerun-if-changed=cpp/hello.h");
     println!("cargo:rerun-if-changed=cpp/math_lib.cpp");
     println!("cargo:rerun-if-changed=cpp/math_lib.h");
+    println!("cargo:rerun-if-changed=cpp/color_bridge.cpp");
+    println!("cargo:rerun-if-changed=cpp/color_bridge.h");
+    println!("cargo:rerun-if-changed=cpp/image_ops.cpp");
+    println!("cargo:rerun-if-changed=cpp/image_ops.h");
+    println!("cargo:rerun-if-changed=../src/color");
+    println!("cargo:rerun-if-changed=../include/color");
     println!("cargo:rerun-if-changed=src/lib.rs");
 }
@@ -0,0 +1,258 @@
+#include "color_bridge.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    size_t pixelCount(size_t inputLength, size_t channels, size_t outputLength) {
+        if (inputLength % channels != 0) {
+            throw std::invalid_argument("input length is not a multiple of the channel count");
+        }
+        size_t pixels = inputLength / channels;
+        if (outputLength != pixels * 4) {
+            throw std::invalid_argument("output length must be 4 samples per input pixel");
+        }
+        return pixels;
+    }
+
+    void check(bool ok) {
+        if (!ok) throw std::runtime_error("color conversion failed");
+    }
+}
+
+std::unique_ptr<ColorBridge> new_color_bridge(rust::Str rgb_profile, rust::Str cmyk_profile) {
+    auto bridge = std::make_unique<ColorBridge>();
+    if (!bridge->converter.initialize(std::string(rgb_profile), std::string(cmyk_profile))) {
+        throw std::runtime_error("failed to load ICC profiles");
+    }
+    return bridge;
+}
+
+void ColorBridge::set_thread_count(uint32_t count) {
+    converter.setThreadCount(count);
+}
+
+void ColorBridge::convert_rgb8_to_cmyk16(rust::Slice<const uint8_t> rgb, rust::Slice<uint16_t> cmyk) const {
+    size_t pixels = pixelCount(rgb.size(), 3, cmyk.size());
+    check(converter.convert(rgb.data(), PixelFormat::RGB8, cmyk.data(), PixelFormat::CMYK16, pixels));
+}
+
+void ColorBridge::convert_rgba8_to_cmyk16(rust::Slice<const uint8_t> rgba, rust::Slice<uint16_t> cmyk) const {
+    size_t pixels = pixelCount(rgba.size(), 4, cmyk.size());
+    check(converter.convert(rgba.data(), PixelFormat::RGBA8, cmyk.data(), PixelFormat::CMYK16, pixels));
+}
+
+void ColorBridge::convert_rgba8_to_cmyk16_region(rust::Slice<const uint8_t> rgba, rust::Slice<uint16_t> cmyk,
+                                                 uint32_t width, uint32_t height,
+                                                 uint32_t x, uint32_t y,
+                                                 uint32_t region_width, uint32_t region_height) const {
+    size_t pixels = pixelCount(rgba.size(), 4, cmyk.size());
+    if (pixels != static_cast<size_t>(width) * height) {
+        throw std::invalid_argument("buffer length does not match width * height");
+    }
+    if (static_cast<uint64_t>(x) + region_width > width || static_cast<uint64_t>(y) + region_height > height) {
+        throw std::invalid_argument("region is outside the image");
+    }
+    PixelRect region{x, y, region_width, region_height};
+    check(converter.convert(rgba.data(), PixelFormat::RGBA8, 0,
+                            cmyk.data(), PixelFormat::CMYK16, 0,
+                            width, height, region));
+}
+
+void ColorBridge::convert_rgb16_to_cmyk16(rust::Slice<const uint16_t> rgb, rust::Slice<uint16_t> cmyk) const {
+    size_t pixels = pixelCount(rgb.size(), 3, cmyk.size());
+    check(converter.convert(rgb.data(), PixelFormat::RGB16, cmyk.data(), PixelFormat::CMYK16, pixels));
+}
+
+void ColorBridge::convert_rgba8_to_cmyk16_bytes(rust::Slice<const uint8_t> rgba, rust::Slice<uint8_t> cmyk) const {
+    if (cmyk.size() % sizeof(uint16_t) != 0) {
+        throw std::invalid_argument("output length must be a whole number of 16-bit samples");
+    }
+    size_t pixels = pixelCount(rgba.size(), 4, cmyk.size() / sizeof(uint16_t));
+    if (reinterpret_cast<uintptr_t>(cmyk.data()) % alignof(CMYK16) == 0) {
+        check(converter.convert(rgba.data(), PixelFormat::RGBA8, cmyk.data(), PixelFormat::CMYK16, pixels));
+        return;
+    }
+    // Hizasız çıktı uint16_t olarak yazılamaz; hizalı geçici buffer'dan kopyalanır
+    std::vector<CMYK16> aligned(pixels);
+    check(converter.convert(rgba.data(), PixelFormat::RGBA8, aligned.data(), PixelFormat::CMYK16, pixels));
+    std::memcpy(cmyk.data(), aligned.data(), pixels * sizeof(CMYK16));
+}
+
+namespace {
+    ProofView proofView(uint32_t x, uint32_t y, uint32_t width, uint32_t height,
+                        uint32_t targetWidth, uint32_t targetHeight) {
+        ProofView view;
+        view.source = PixelRect{x, y, width, height};
+        view.targetWidth = targetWidth;
+        view.targetHeight = targetHeight;
+        return view;
+    }
+
+    void putU32(uint8_t* out, size_t value) {
+        for (int i = 0; i < 4; ++i) out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+std::unique_ptr<SoftProofBridge> new_soft_proof_bridge(rust::Str rgb_profile, rust::Str cmyk_profile,
+                                                       rust::Str display_profile) {
+    auto bridge = std::make_unique<SoftProofBridge>();
+    if (!bridge->proofer.initialize(std::string(rgb_profile), std::string(cmyk_profile),
+                                    std::string(display_profile))) {
+        throw std::runtime_error("failed to create the soft-proof transform");
+    }
+    return bridge;
+}
+
+void SoftProofBridge::set_image(rust::Slice<const uint8_t> rgba, uint32_t width, uint32_t height) {
+    if (rgba.size() != static_cast<size_t>(width) * height * sizeof(RGBA8)) {
+        throw std::invalid_argument("buffer length does not match width * height * 4");
+    }
+    proofer.setImage(reinterpret_cast<const RGBA8*>(rgba.data()), width, height);
+}
+
+uint32_t SoftProofBridge::level_count() const {
+    return proofer.levelCount();
+}
+
+uint32_t SoftProofBridge::preview_level(uint32_t x, uint32_t y, uint32_t width, uint32_t height,
+                                        uint32_t target_width, uint32_t target_height) const {
+    return proofer.previewLevelFor(proofView(x, y, width, height, target_width, target_height));
+}
+
+uint32_t SoftProofBridge::final_level(uint32_t x, uint32_t y, uint32_t width, uint32_t height,
+                                      uint32_t target_width, uint32_t target_height) const {
+    return proofer.levelFor(proofView(x, y, width, height, target_width, target_height));
+}
+
+uint64_t SoftProofBridge::begin_view() const {
+    return proofer.cancel();
+}
+
+size_t SoftProofBridge::frame_size(uint32_t level, uint32_t x, uint32_t y,
+                                   uint32_t width, uint32_t height) const {
+    const uint64_t unit = uint64_t(1) << std::min<uint32_t>(level, 63);
+    const uint64_t levelWidth = proofer.levelWidth(level);
+    const uint64_t levelHeight = proofer.levelHeight(level);
+    // SoftProofer::render ile aynı dışa doğru yuvarlama
+    const uint64_t x0 = std::min<uint64_t>(x / unit, levelWidth);
+    const uint64_t y0 = std::min<uint64_t>(y / unit, levelHeight);
+    const uint64_t x1 = std::min<uint64_t>((uint64_t(x) + width + unit - 1) / unit, levelWidth);
+    const uint64_t y1 = std::min<uint64_t>((uint64_t(y) + height + unit - 1) / unit, levelHeight);
+    return 16 + static_cast<size_t>((x1 - x0) * (y1 - y0)) * sizeof(RGBA8);
+}
+
+bool SoftProofBridge::render(uint32_t level, uint32_t x, uint32_t y, uint32_t width, uint32_t height,
+                             uint64_t generation, rust::Slice<uint8_t> out) const {
+    if (level >= proofer.levelCount()) {
+        throw std::invalid_argument("level is out of range");
+    }
+    ProofFrame frame;
+    if (!proofer.render(level, PixelRect{x, y, width, height}, frame, generation)) {
+        return false;
+    }
+
+    const size_t bytes = frame.pixels.size() * sizeof(RGBA8);
+    if (out.size() != 16 + bytes) {
+        throw std::invalid_argument("output length does not match frame_size");
+    }
+    putU32(out.data(), frame.region.x);
+    putU32(out.data() + 4, frame.region.y);
+    putU32(out.data() + 8, frame.region.width);
+    putU32(out.data() + 12, frame.region.height);
+    std::memcpy(out.data() + 16, frame.pixels.data(), bytes);
+    return true;
+}
+
+std::unique_ptr<ConversionJobsBridge> new_conversion_jobs_bridge(uint32_t concurrent) {
+    return std::unique_ptr<ConversionJobsBridge>(new ConversionJobsBridge(concurrent));
+}
+
+uint64_t ConversionJobsBridge::submit_image(rust::Str input_path, rust::Str output_path,
+                                            rust::Str rgb_profile, rust::Str cmyk_profile,
+                                            uint32_t threads, bool pyramid) const {
+    ConversionRequest request;
+    request.inputPath = std::string(input_path);
+    request.outputPath = std::string(output_path);
+    request.rgbProfilePath = std::string(rgb_profile);
+    request.cmykProfilePath = std::string(cmyk_profile);
+    request.threads = threads;
+    if (pyramid) {
+        request.tiff.pyramid = true;
+        request.tiff.compression = TiffCompression::Deflate;
+        request.tiff.predictor = true;
+    }
+
+    std::shared_ptr<ConversionJob> job = queue.submit(request);
+    std::lock_guard<std::mutex> lock(mutex);
+    prune();
+    jobs[job->id()].job = job;
+    return job->id();
+}
+
+void ConversionJobsBridge::prune() const {
+    // Bitiş, bir sonraki taramada görülür; süre o andan sayılır
+    const auto now = std::chrono::steady_clock::now();
+    for (auto it = jobs.begin(); it != jobs.end();) {
+        Entry& entry = it->second;
+        if (entry.job->finished()) {
+            if (!entry.finishSeen) {
+                entry.finishSeen = true;
+                entry.finishedAt = now;
+            } else if (now - entry.finishedAt >= kFinishedJobLifetime) {
+                it = jobs.erase(it);
+                continue;
+            }
+        }
+        ++it;
+    }
+}
+
+std::shared_ptr<ConversionJob> ConversionJobsBridge::find(uint64_t id) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = jobs.find(id);
+    if (it == jobs.end()) {
+        throw std::invalid_argument("unknown conversion job");
+    }
+    return it->second.job;
+}
+
+uint8_t ConversionJobsBridge::job_state(uint64_t id) const {
+    return static_cast<uint8_t>(find(id)->state());
+}
+
+uint32_t ConversionJobsBridge::job_rows_done(uint64_t id) const {
+    return find(id)->progress().rowsDone;
+}
+
+uint32_t ConversionJobsBridge::job_total_rows(uint64_t id) const {
+    return find(id)->progress().totalRows;
+}
+
+bool ConversionJobsBridge::cancel_job(uint64_t id) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    prune();
+    auto it = jobs.find(id);
+    if (it == jobs.end()) return false;
+    it->second.job->cancel();
+    return true;
+}
+
+void ConversionJobsBridge::wait_job(uint64_t id) const {
+    std::shared_ptr<ConversionJob> job = find(id);
+    const JobResult& result = job->wait();
+    if (result.state == JobState::Cancelled) {
+        throw std::runtime_error("conversion cancelled");
+    }
+    if (result.state == JobState::Failed) {
+        throw std::runtime_error(result.error);
+    }
+}
+
+void ConversionJobsBridge::forget_job(uint64_t id) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    jobs.erase(id);
+}
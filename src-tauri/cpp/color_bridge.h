@@ -0,0 +1,123 @@
+#pragma once
+#include "color/ColorConverter.hpp"
+#include "color/ConversionJob.hpp"
+#include "color/SoftProofer.hpp"
+#include "rust/cxx.h"
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+
+// color_converter kütüphanesinin Rust'a açılan yüzü. Buffer'lar Rust'a aittir;
+// C++ tarafı slice'lar üzerinden doğrudan okur/yazar, ara kopya yapılmaz.
+// set_thread_count paylaşılmadan önce çağrılır; dönüşümler const ve
+// thread-safe'tir (ColorConverter gibi), kilitsiz paralel çağrılabilir.
+class ColorBridge {
+public:
+    ColorBridge() = default;
+
+    void set_thread_count(uint32_t count);
+
+    // Rust slice'ları: girdi piksel sayısı çıktı uzunluğuyla eşleşmelidir
+    void convert_rgb8_to_cmyk16(rust::Slice<const uint8_t> rgb, rust::Slice<uint16_t> cmyk) const;
+    void convert_rgba8_to_cmyk16(rust::Slice<const uint8_t> rgba, rust::Slice<uint16_t> cmyk) const;
+    void convert_rgb16_to_cmyk16(rust::Slice<const uint16_t> rgb, rust::Slice<uint16_t> cmyk) const;
+
+    // Tauri ham (raw) yanıtı için çıktı doğrudan bayt buffer'ına yazılır.
+    // Vec<u8>'in 2 bayt hizası garanti değildir; hizasız buffer'da geçici
+    // bir CMYK16 buffer'a dönüştürülüp kopyalanır.
+    void convert_rgba8_to_cmyk16_bytes(rust::Slice<const uint8_t> rgba, rust::Slice<uint8_t> cmyk) const;
+
+    // width x height sıkışık RGBA8 ve CMYK16 framebuffer'larında yalnızca
+    // (x, y, region_width, region_height) bölgesini yeniden dönüştürür
+    void convert_rgba8_to_cmyk16_region(rust::Slice<const uint8_t> rgba, rust::Slice<uint16_t> cmyk,
+                                        uint32_t width, uint32_t height,
+                                        uint32_t x, uint32_t y,
+                                        uint32_t region_width, uint32_t region_height) const;
+
+    ColorConverter converter;
+};
+
+std::unique_ptr<ColorBridge> new_color_bridge(rust::Str rgb_profile, rust::Str cmyk_profile);
+
+// Baskı önizlemesi. Arayüz bir görünüm için begin_view ile kuşak alır, önce
+// preview_level'i sonra final_level'e kadar ince seviyeleri render eder;
+// yeni bir begin_view süren render'ları keser. render ve sorgular const'tur,
+// aynı anda birden çok thread'den çağrılabilir.
+class SoftProofBridge {
+public:
+    void set_image(rust::Slice<const uint8_t> rgba, uint32_t width, uint32_t height);
+
+    uint32_t level_count() const;
+    uint32_t preview_level(uint32_t x, uint32_t y, uint32_t width, uint32_t height,
+                           uint32_t target_width, uint32_t target_height) const;
+    uint32_t final_level(uint32_t x, uint32_t y, uint32_t width, uint32_t height,
+                         uint32_t target_width, uint32_t target_height) const;
+
+    uint64_t begin_view() const;
+
+    // render'ın yazacağı bayt sayısı: 16 baytlık başlık + RGBA8 pikseller
+    size_t frame_size(uint32_t level, uint32_t x, uint32_t y, uint32_t width, uint32_t height) const;
+
+    // out: 16 baytlık başlık (seviye koordinatlarında x, y, genişlik, yükseklik;
+    // little-endian u32) ve ardından ekran profilinde RGBA8 pikseller.
+    // Kuşak bu sırada değiştiyse false döner.
+    bool render(uint32_t level, uint32_t x, uint32_t y, uint32_t width, uint32_t height,
+                uint64_t generation, rust::Slice<uint8_t> out) const;
+
+    // SoftProofer kendi iptal sayacını ve thread'ini yönetir; begin_view bunu
+    // const arayüzden ilerletir
+    mutable SoftProofer proofer;
+};
+
+// display_profile boşsa ekran sRGB kabul edilir
+std::unique_ptr<SoftProofBridge> new_soft_proof_bridge(rust::Str rgb_profile, rust::Str cmyk_profile,
+                                                       rust::Str display_profile);
+
+// Dosyadan dosyaya eşzamansız dönüşüm. İşler kimlikle anılır; durum ve
+// ilerleme sorguları bloklamaz, Rust tarafı bunları olay olarak yayınlar.
+// Tüm metotlar const ve thread-safe'tir.
+class ConversionJobsBridge {
+public:
+    explicit ConversionJobsBridge(uint32_t concurrent) : queue(concurrent) {}
+
+    // pyramid: görüntüleyici için tile'lı, çok çözünürlüklü TIFF
+    uint64_t submit_image(rust::Str input_path, rust::Str output_path,
+                          rust::Str rgb_profile, rust::Str cmyk_profile,
+                          uint32_t threads, bool pyramid) const;
+
+    // JobState sırası: 0 queued, 1 running, 2 succeeded, 3 failed, 4 cancelled
+    uint8_t job_state(uint64_t id) const;
+    uint32_t job_rows_done(uint64_t id) const;
+    uint32_t job_total_rows(uint64_t id) const;
+
+    // İş bilinmiyorsa false
+    bool cancel_job(uint64_t id) const;
+
+    // İş bitene kadar bloklar; başarısız veya iptal edildiyse istisna atar
+    void wait_job(uint64_t id) const;
+
+    // Bitmiş işin kaydını bırakır. Hiç bırakılmayan (beklenmeyen) bitmiş
+    // işler kFinishedJobLifetime sonra submit_image/cancel_job'da silinir.
+    void forget_job(uint64_t id) const;
+
+private:
+    static constexpr std::chrono::minutes kFinishedJobLifetime{10};
+
+    struct Entry {
+        std::shared_ptr<ConversionJob> job;
+        bool finishSeen = false;
+        std::chrono::steady_clock::time_point finishedAt;
+    };
+
+    std::shared_ptr<ConversionJob> find(uint64_t id) const;
+    // mutex tutulurken çağrılır
+    void prune() const;
+
+    mutable std::mutex mutex;
+    mutable std::map<uint64_t, Entry> jobs;
+    // Yıkıcısı süren işleri iptal edip bitmelerini bekler
+    mutable ConversionQueue queue;
+};
+
+std::unique_ptr<ConversionJobsBridge> new_conversion_jobs_bridge(uint32_t concurrent);
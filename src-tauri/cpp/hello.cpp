@@ -1,5 +1,7 @@
 #include "hello.h"
 #include <iostream>
+#include <stdexcept>
+#include <string>
 
 void say_hello() {
     std::cout << "Hello World from C++!" << std::endl;
@@ -43,4 +45,40 @@ double calculate_power(double base, double exp) {
 double calculate_abs(double x) {
     std::cout << "C++: Calculating absolute value of " << x << std::endl;
     return math_lib::Calculator::absolute(x);
-} 
\ No newline at end of file
+}
+
+// Batch entry point: one FFI call and no logging per element
+void calculate_batch(rust::Str operation, rust::Slice<const double> a,
+                     rust::Slice<const double> b, rust::Slice<double> out) {
+    const std::string op(operation);
+    const size_t n = a.size();
+    if (out.size() != n) {
+        throw std::invalid_argument("output length must match input length");
+    }
+
+    if (op == "sqrt") {
+        math_lib::Calculator::square_root_batch(a.data(), out.data(), n);
+        return;
+    }
+    if (op == "abs") {
+        math_lib::Calculator::absolute_batch(a.data(), out.data(), n);
+        return;
+    }
+
+    if (b.size() != n) {
+        throw std::invalid_argument("a and b must have the same length");
+    }
+    if (op == "add") {
+        math_lib::Calculator::add_batch(a.data(), b.data(), out.data(), n);
+    } else if (op == "subtract") {
+        math_lib::Calculator::subtract_batch(a.data(), b.data(), out.data(), n);
+    } else if (op == "multiply") {
+        math_lib::Calculator::multiply_batch(a.data(), b.data(), out.data(), n);
+    } else if (op == "divide") {
+        math_lib::Calculator::divide_batch(a.data(), b.data(), out.data(), n);
+    } else if (op == "power") {
+        math_lib::Calculator::power_batch(a.data(), b.data(), out.data(), n);
+    } else {
+        throw std::invalid_argument("Unknown operation: " + op);
+    }
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include "math_lib.h"
+#include "rust/cxx.h"
 
 void say_hello();
 double add(double a, double b);
@@ -10,4 +11,10 @@ double divide(double a, double b);
 // New math functions using our library
 double calculate_sqrt(double x);
 double calculate_power(double base, double exp);
-double calculate_abs(double x); 
\ No newline at end of file
+double calculate_abs(double x);
+
+// Batch calculator for the cxx bridge: out[i] = operation(a[i], b[i]).
+// b is ignored (and may be empty) for "sqrt" and "abs". Throws on unknown
+// operations or mismatched lengths.
+void calculate_batch(rust::Str operation, rust::Slice<const double> a,
+                     rust::Slice<const double> b, rust::Slice<double> out);
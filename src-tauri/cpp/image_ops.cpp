@@ -0,0 +1,280 @@
+#include "image_ops.h"
+#include "stb_image.h"
+#include "stb_image_write.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr int kMaxDimension = 1024;
+    constexpr int kJpegQuality = 85;
+    constexpr double kPi = 3.14159265358979323846;
+
+    struct Image {
+        int width = 0;
+        int height = 0;
+        std::vector<uint8_t> pixels;   // RGB, satır satır
+
+        uint8_t* at(int x, int y) { return &pixels[(static_cast<size_t>(y) * width + x) * 3]; }
+    };
+
+    // ---- Lanczos (a = 3) yeniden örnekleme, PIL LANCZOS ile aynı çekirdek ----
+
+    double sinc(double x) {
+        if (x == 0.0) return 1.0;
+        x *= kPi;
+        return std::sin(x) / x;
+    }
+
+    double lanczos3(double x) {
+        return (x > -3.0 && x < 3.0) ? sinc(x) * sinc(x / 3.0) : 0.0;
+    }
+
+    // Her çıktı konumu için katkı veren girdi aralığı ve normalize ağırlıklar
+    struct Taps {
+        std::vector<int> first;
+        std::vector<int> count;
+        std::vector<float> weights;   // çıktı başına maxTaps ağırlık
+        int maxTaps = 0;
+    };
+
+    Taps computeTaps(int srcLen, int dstLen) {
+        const double scale = static_cast<double>(srcLen) / dstLen;
+        const double filterScale = std::max(scale, 1.0);   // küçültmede çekirdek genişler
+        const double support = 3.0 * filterScale;
+
+        Taps taps;
+        taps.maxTaps = static_cast<int>(std::ceil(support)) * 2 + 1;
+        taps.first.resize(dstLen);
+        taps.count.resize(dstLen);
+        taps.weights.assign(static_cast<size_t>(dstLen) * taps.maxTaps, 0.0f);
+
+        for (int i = 0; i < dstLen; ++i) {
+            const double center = (i + 0.5) * scale;
+            int lo = std::max(0, static_cast<int>(std::floor(center - support)));
+            int hi = std::min(srcLen, static_cast<int>(std::ceil(center + support)));
+            hi = std::min(hi, lo + taps.maxTaps);
+
+            float* w = &taps.weights[static_cast<size_t>(i) * taps.maxTaps];
+            double sum = 0.0;
+            for (int j = lo; j < hi; ++j) {
+                double v = lanczos3((j + 0.5 - center) / filterScale);
+                w[j - lo] = static_cast<float>(v);
+                sum += v;
+            }
+            if (sum != 0.0) {
+                for (int j = 0; j < hi - lo; ++j) w[j] = static_cast<float>(w[j] / sum);
+            }
+            taps.first[i] = lo;
+            taps.count[i] = hi - lo;
+        }
+        return taps;
+    }
+
+    uint8_t clampByte(float v) {
+        return static_cast<uint8_t>(std::min(255.0f, std::max(0.0f, v + 0.5f)));
+    }
+
+    // Ayrılabilir iki geçiş: önce yatay (float ara buffer), sonra dikey
+    Image resizeLanczos(const Image& src, int dstWidth, int dstHeight) {
+        const Taps horizontal = computeTaps(src.width, dstWidth);
+        const Taps vertical = computeTaps(src.height, dstHeight);
+
+        std::vector<float> tmp(static_cast<size_t>(src.height) * dstWidth * 3);
+        for (int y = 0; y < src.height; ++y) {
+            const uint8_t* row = &src.pixels[static_cast<size_t>(y) * src.width * 3];
+            float* out = &tmp[static_cast<size_t>(y) * dstWidth * 3];
+            for (int x = 0; x < dstWidth; ++x) {
+                const float* w = &horizontal.weights[static_cast<size_t>(x) * horizontal.maxTaps];
+                const uint8_t* p = row + static_cast<size_t>(horizontal.first[x]) * 3;
+                float r = 0, g = 0, b = 0;
+                for (int k = 0; k < horizontal.count[x]; ++k, p += 3) {
+                    r += w[k] * p[0];
+                    g += w[k] * p[1];
+                    b += w[k] * p[2];
+                }
+                out[x * 3 + 0] = r;
+                out[x * 3 + 1] = g;
+                out[x * 3 + 2] = b;
+            }
+        }
+
+        Image dst;
+        dst.width = dstWidth;
+        dst.height = dstHeight;
+        dst.pixels.resize(static_cast<size_t>(dstWidth) * dstHeight * 3);
+        const size_t rowStride = static_cast<size_t>(dstWidth) * 3;
+        std::vector<float> acc(rowStride);
+        for (int y = 0; y < dstHeight; ++y) {
+            std::fill(acc.begin(), acc.end(), 0.0f);
+            const float* w = &vertical.weights[static_cast<size_t>(y) * vertical.maxTaps];
+            for (int k = 0; k < vertical.count[y]; ++k) {
+                const float* in = &tmp[(static_cast<size_t>(vertical.first[y]) + k) * rowStride];
+                for (size_t i = 0; i < rowStride; ++i) acc[i] += w[k] * in[i];
+            }
+            uint8_t* out = &dst.pixels[static_cast<size_t>(y) * rowStride];
+            for (size_t i = 0; i < rowStride; ++i) out[i] = clampByte(acc[i]);
+        }
+        return dst;
+    }
+
+    // ---- İşaretleme ----
+
+    void putPixel(Image& img, int x, int y, const uint8_t color[3]) {
+        if (x < 0 || y < 0 || x >= img.width || y >= img.height) return;
+        uint8_t* p = img.at(x, y);
+        p[0] = color[0];
+        p[1] = color[1];
+        p[2] = color[2];
+    }
+
+    void drawCircle(Image& img, int cx, int cy, int radius, int thickness, const uint8_t color[3]) {
+        const double half = thickness / 2.0;
+        const int extent = radius + thickness;
+        for (int y = cy - extent; y <= cy + extent; ++y) {
+            for (int x = cx - extent; x <= cx + extent; ++x) {
+                double d = std::sqrt(double(x - cx) * (x - cx) + double(y - cy) * (y - cy));
+                if (std::fabs(d - radius) <= half) putPixel(img, x, y, color);
+            }
+        }
+    }
+
+    // 5x7 bitmap font; yalnızca bilgi satırlarında geçen karakterler
+    struct Glyph {
+        char ch;
+        const char* rows[7];
+    };
+
+    const Glyph kFont[] = {
+        {'0', {"01110", "10001", "10011", "10101", "11001", "10001", "01110"}},
+        {'1', {"00100", "01100", "00100", "00100", "00100", "00100", "01110"}},
+        {'2', {"01110", "10001", "00001", "00010", "00100", "01000", "11111"}},
+        {'3', {"11111", "00010", "00100", "00010", "00001", "10001", "01110"}},
+        {'4', {"00010", "00110", "01010", "10010", "11111", "00010", "00010"}},
+        {'5', {"11111", "10000", "11110", "00001", "00001", "10001", "01110"}},
+        {'6', {"00110", "01000", "10000", "11110", "10001", "10001", "01110"}},
+        {'7', {"11111", "00001", "00010", "00100", "01000", "01000", "01000"}},
+        {'8', {"01110", "10001", "10001", "01110", "10001", "10001", "01110"}},
+        {'9', {"01110", "10001", "10001", "01111", "00001", "00010", "01100"}},
+        {'A', {"01110", "10001", "10001", "11111", "10001", "10001", "10001"}},
+        {'B', {"11110", "10001", "10001", "11110", "10001", "10001", "11110"}},
+        {'C', {"01110", "10001", "10000", "10000", "10000", "10001", "01110"}},
+        {'D', {"11100", "10010", "10001", "10001", "10001", "10010", "11100"}},
+        {'E', {"11111", "10000", "10000", "11110", "10000", "10000", "11111"}},
+        {'F', {"11111", "10000", "10000", "11110", "10000", "10000", "10000"}},
+        {'G', {"01110", "10001", "10000", "10111", "10001", "10001", "01111"}},
+        {'H', {"10001", "10001", "10001", "11111", "10001", "10001", "10001"}},
+        {'I', {"01110", "00100", "00100", "00100", "00100", "00100", "01110"}},
+        {'J', {"00111", "00010", "00010", "00010", "00010", "10010", "01100"}},
+        {'K', {"10001", "10010", "10100", "11000", "10100", "10010", "10001"}},
+        {'L', {"10000", "10000", "10000", "10000", "10000", "10000", "11111"}},
+        {'M', {"10001", "11011", "10101", "10101", "10001", "10001", "10001"}},
+        {'N', {"10001", "10001", "11001", "10101", "10011", "10001", "10001"}},
+        {'O', {"01110", "10001", "10001", "10001", "10001", "10001", "01110"}},
+        {'P', {"11110", "10001", "10001", "11110", "10000", "10000", "10000"}},
+        {'Q', {"01110", "10001", "10001", "10001", "10101", "10010", "01101"}},
+        {'R', {"11110", "10001", "10001", "11110", "10100", "10010", "10001"}},
+        {'S', {"01111", "10000", "10000", "01110", "00001", "00001", "11110"}},
+        {'T', {"11111", "00100", "00100", "00100", "00100", "00100", "00100"}},
+        {'U', {"10001", "10001", "10001", "10001", "10001", "10001", "01110"}},
+        {'V', {"10001", "10001", "10001", "10001", "10001", "01010", "00100"}},
+        {'W', {"10001", "10001", "10001", "10101", "10101", "10101", "01010"}},
+        {'X', {"10001", "10001", "01010", "00100", "01010", "10001", "10001"}},
+        {'Y', {"10001", "10001", "10001", "01010", "00100", "00100", "00100"}},
+        {'Z', {"11111", "00001", "00010", "00100", "01000", "10000", "11111"}},
+        {':', {"00000", "01100", "01100", "00000", "01100", "01100", "00000"}},
+        {'.', {"00000", "00000", "00000", "00000", "00000", "01100", "01100"}},
+    };
+
+    const Glyph* findGlyph(char ch) {
+        if (ch >= 'a' && ch <= 'z') ch = static_cast<char>(ch - 'a' + 'A');
+        for (const Glyph& glyph : kFont) {
+            if (glyph.ch == ch) return &glyph;
+        }
+        return nullptr;   // boşluk ve bilinmeyenler boş bırakılır
+    }
+
+    // (x, baseline) sol alt köşe; her font pikseli scale x scale kare
+    void drawText(Image& img, const std::string& text, int x, int baseline, int scale, const uint8_t color[3]) {
+        const int top = baseline - 7 * scale;
+        for (char ch : text) {
+            if (const Glyph* glyph = findGlyph(ch)) {
+                for (int row = 0; row < 7; ++row) {
+                    for (int col = 0; col < 5; ++col) {
+                        if (glyph->rows[row][col] != '1') continue;
+                        for (int dy = 0; dy < scale; ++dy)
+                            for (int dx = 0; dx < scale; ++dx)
+                                putPixel(img, x + col * scale + dx, top + row * scale + dy, color);
+                    }
+                }
+            }
+            x += 6 * scale;
+        }
+    }
+
+    void appendToVec(void* context, void* data, int size) {
+        auto* out = static_cast<rust::Vec<uint8_t>*>(context);
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (int i = 0; i < size; ++i) out->push_back(bytes[i]);
+    }
+}
+
+rust::Vec<uint8_t> process_image_native(rust::Slice<const uint8_t> encoded) {
+    const auto started = std::chrono::steady_clock::now();
+    std::vector<std::string> info;
+
+    Image img;
+    int channels = 0;
+    std::unique_ptr<uint8_t, void (*)(void*)> decoded(
+        stbi_load_from_memory(encoded.data(), static_cast<int>(encoded.size()),
+                              &img.width, &img.height, &channels, 3),
+        stbi_image_free);
+    if (!decoded) {
+        throw std::runtime_error(std::string("Failed to load image - ") + stbi_failure_reason());
+    }
+    img.pixels.assign(decoded.get(), decoded.get() + static_cast<size_t>(img.width) * img.height * 3);
+    decoded.reset();
+
+    info.push_back("Original size: " + std::to_string(img.width) + "x" + std::to_string(img.height));
+
+    // Çok büyükse uzun kenarı 1024 olacak şekilde küçült
+    if (std::max(img.width, img.height) > kMaxDimension) {
+        double ratio = static_cast<double>(kMaxDimension) / std::max(img.width, img.height);
+        int newWidth = std::max(1, static_cast<int>(img.width * ratio));
+        int newHeight = std::max(1, static_cast<int>(img.height * ratio));
+        img = resizeLanczos(img, newWidth, newHeight);
+        info.push_back("Resized to: " + std::to_string(newWidth) + "x" + std::to_string(newHeight));
+    }
+
+    // Merkeze kırmızı daire
+    const uint8_t red[3] = {255, 0, 0};
+    const uint8_t blue[3] = {0, 0, 255};
+    drawCircle(img, img.width / 2, img.height / 2,
+               std::min(50, img.width / 10), std::max(1, img.width / 500), red);
+
+    // Bilgi satırları
+    const double fontScale = std::max(0.5, img.width / 1000.0);
+    const int scale = std::max(1, static_cast<int>(std::lround(3 * fontScale)));
+    const int yPosition = 30;
+    for (size_t i = 0; i < info.size(); ++i) {
+        drawText(img, info[i], 30, yPosition + static_cast<int>(i) * 30, scale, blue);
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    char timing[64];
+    std::snprintf(timing, sizeof(timing), "Processing time: %.3fs", seconds);
+    drawText(img, timing, 30, yPosition + static_cast<int>(info.size()) * 30, scale, blue);
+
+    rust::Vec<uint8_t> jpeg;
+    jpeg.reserve(static_cast<size_t>(img.width) * img.height / 4);
+    if (!stbi_write_jpg_to_func(appendToVec, &jpeg, img.width, img.height, 3,
+                                img.pixels.data(), kJpegQuality)) {
+        throw std::runtime_error("Failed to encode processed image");
+    }
+    return jpeg;
+}
@@ -0,0 +1,8 @@
+#pragma once
+#include "rust/cxx.h"
+#include <cstdint>
+
+// Python process_image'ın yerel karşılığı: decode -> (gerekirse) Lanczos ile
+// 1024 piksele küçültme -> işaretleme (daire + bilgi metni) -> JPEG encode.
+// Kodlanmış görüntü baytlarını alır, JPEG baytlarını döner; hata olursa istisna fırlatır.
+rust::Vec<uint8_t> process_image_native(rust::Slice<const uint8_t> encoded);
@@ -1,6 +1,16 @@
 #include "math_lib.h"
 #include <iostream>
 
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#include <immintrin.h>
+#define MATH_LIB_X86 1
+#endif
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define MATH_LIB_NEON 1
+#endif
+
 namespace math_lib {
     double Calculator::square_root(double x) {
         if (x < 0) {
@@ -17,4 +27,183 @@ namespace math_lib {
     double Calculator::absolute(double x) {
         return std::abs(x);
     }
-} 
\ No newline at end of file
+
+    namespace {
+        using BinaryKernel = void (*)(const double*, const double*, double*, size_t);
+        using UnaryKernel = void (*)(const double*, double*, size_t);
+
+        struct Kernels {
+            const char* name;
+            BinaryKernel add;
+            BinaryKernel subtract;
+            BinaryKernel multiply;
+            BinaryKernel divide;
+            UnaryKernel square_root;
+            UnaryKernel absolute;
+        };
+
+        // Scalar kernels, also used for the tails of the SIMD loops
+        void add_scalar(const double* a, const double* b, double* out, size_t n) {
+            for (size_t i = 0; i < n; ++i) out[i] = a[i] + b[i];
+        }
+        void subtract_scalar(const double* a, const double* b, double* out, size_t n) {
+            for (size_t i = 0; i < n; ++i) out[i] = a[i] - b[i];
+        }
+        void multiply_scalar(const double* a, const double* b, double* out, size_t n) {
+            for (size_t i = 0; i < n; ++i) out[i] = a[i] * b[i];
+        }
+        void divide_scalar(const double* a, const double* b, double* out, size_t n) {
+            for (size_t i = 0; i < n; ++i) out[i] = b[i] == 0 ? 0.0 : a[i] / b[i];
+        }
+        void square_root_scalar(const double* x, double* out, size_t n) {
+            for (size_t i = 0; i < n; ++i) out[i] = x[i] < 0 ? 0.0 : std::sqrt(x[i]);
+        }
+        void absolute_scalar(const double* x, double* out, size_t n) {
+            for (size_t i = 0; i < n; ++i) out[i] = std::abs(x[i]);
+        }
+
+        const Kernels scalar_kernels = {
+            "scalar", add_scalar, subtract_scalar, multiply_scalar, divide_scalar,
+            square_root_scalar, absolute_scalar
+        };
+
+#if defined(MATH_LIB_X86) && (defined(__GNUC__) || defined(__clang__))
+#define MATH_LIB_AVX2 1
+        // 4 doubles per iteration; compiled for AVX2 regardless of -march,
+        // only called after a runtime CPU check.
+#define AVX2_BINARY(name, expr)                                                     \
+        __attribute__((target("avx2"))) void name##_avx2(const double* a, const double* b, \
+                                                         double* out, size_t n) {   \
+            size_t i = 0;                                                           \
+            for (; i + 4 <= n; i += 4) {                                            \
+                __m256d va = _mm256_loadu_pd(a + i);                                \
+                __m256d vb = _mm256_loadu_pd(b + i);                                \
+                _mm256_storeu_pd(out + i, expr);                                    \
+            }                                                                       \
+            name##_scalar(a + i, b + i, out + i, n - i);                            \
+        }
+
+        AVX2_BINARY(add, _mm256_add_pd(va, vb))
+        AVX2_BINARY(subtract, _mm256_sub_pd(va, vb))
+        AVX2_BINARY(multiply, _mm256_mul_pd(va, vb))
+        // b == 0 lanes are forced to 0 to match the scalar divide()
+        AVX2_BINARY(divide, _mm256_andnot_pd(_mm256_cmp_pd(vb, _mm256_setzero_pd(), _CMP_EQ_OQ),
+                                             _mm256_div_pd(va, vb)))
+#undef AVX2_BINARY
+
+        __attribute__((target("avx2"))) void square_root_avx2(const double* x, double* out, size_t n) {
+            size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                // Negative inputs clamp to 0, so sqrt gives 0 like the scalar path
+                __m256d v = _mm256_max_pd(_mm256_loadu_pd(x + i), _mm256_setzero_pd());
+                _mm256_storeu_pd(out + i, _mm256_sqrt_pd(v));
+            }
+            square_root_scalar(x + i, out + i, n - i);
+        }
+
+        __attribute__((target("avx2"))) void absolute_avx2(const double* x, double* out, size_t n) {
+            const __m256d sign = _mm256_set1_pd(-0.0);
+            size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                _mm256_storeu_pd(out + i, _mm256_andnot_pd(sign, _mm256_loadu_pd(x + i)));
+            }
+            absolute_scalar(x + i, out + i, n - i);
+        }
+
+        const Kernels avx2_kernels = {
+            "avx2", add_avx2, subtract_avx2, multiply_avx2, divide_avx2,
+            square_root_avx2, absolute_avx2
+        };
+#endif
+
+#if defined(MATH_LIB_NEON)
+        // 2 doubles per iteration; NEON is always available on AArch64
+#define NEON_BINARY(name, expr)                                                     \
+        void name##_neon(const double* a, const double* b, double* out, size_t n) { \
+            size_t i = 0;                                                           \
+            for (; i + 2 <= n; i += 2) {                                            \
+                float64x2_t va = vld1q_f64(a + i);                                  \
+                float64x2_t vb = vld1q_f64(b + i);                                  \
+                vst1q_f64(out + i, expr);                                           \
+            }                                                                       \
+            name##_scalar(a + i, b + i, out + i, n - i);                            \
+        }
+
+        NEON_BINARY(add, vaddq_f64(va, vb))
+        NEON_BINARY(subtract, vsubq_f64(va, vb))
+        NEON_BINARY(multiply, vmulq_f64(va, vb))
+        NEON_BINARY(divide, vreinterpretq_f64_u64(vbicq_u64(vreinterpretq_u64_f64(vdivq_f64(va, vb)),
+                                                            vceqzq_f64(vb))))
+#undef NEON_BINARY
+
+        void square_root_neon(const double* x, double* out, size_t n) {
+            size_t i = 0;
+            for (; i + 2 <= n; i += 2) {
+                float64x2_t v = vmaxq_f64(vld1q_f64(x + i), vdupq_n_f64(0.0));
+                vst1q_f64(out + i, vsqrtq_f64(v));
+            }
+            square_root_scalar(x + i, out + i, n - i);
+        }
+
+        void absolute_neon(const double* x, double* out, size_t n) {
+            size_t i = 0;
+            for (; i + 2 <= n; i += 2) vst1q_f64(out + i, vabsq_f64(vld1q_f64(x + i)));
+            absolute_scalar(x + i, out + i, n - i);
+        }
+
+        const Kernels neon_kernels = {
+            "neon", add_neon, subtract_neon, multiply_neon, divide_neon,
+            square_root_neon, absolute_neon
+        };
+#endif
+
+        const Kernels& select_kernels() {
+#if defined(MATH_LIB_AVX2)
+            if (__builtin_cpu_supports("avx2")) return avx2_kernels;
+#endif
+#if defined(MATH_LIB_NEON)
+            return neon_kernels;
+#endif
+            return scalar_kernels;
+        }
+
+        const Kernels& kernels() {
+            static const Kernels& selected = select_kernels();
+            return selected;
+        }
+    }
+
+    void Calculator::add_batch(const double* a, const double* b, double* out, size_t n) {
+        kernels().add(a, b, out, n);
+    }
+
+    void Calculator::subtract_batch(const double* a, const double* b, double* out, size_t n) {
+        kernels().subtract(a, b, out, n);
+    }
+
+    void Calculator::multiply_batch(const double* a, const double* b, double* out, size_t n) {
+        kernels().multiply(a, b, out, n);
+    }
+
+    void Calculator::divide_batch(const double* a, const double* b, double* out, size_t n) {
+        kernels().divide(a, b, out, n);
+    }
+
+    void Calculator::power_batch(const double* base, const double* exponent, double* out, size_t n) {
+        // No vector pow in AVX2/NEON; a tight loop without per-call FFI and
+        // logging is where the time goes, and the compiler can unroll it.
+        for (size_t i = 0; i < n; ++i) out[i] = std::pow(base[i], exponent[i]);
+    }
+
+    void Calculator::square_root_batch(const double* x, double* out, size_t n) {
+        kernels().square_root(x, out, n);
+    }
+
+    void Calculator::absolute_batch(const double* x, double* out, size_t n) {
+        kernels().absolute(x, out, n);
+    }
+
+    const char* Calculator::simd_backend() {
+        return kernels().name;
+    }
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include <cmath>
+#include <cstddef>
 
 namespace math_lib {
     class Calculator {
@@ -7,5 +8,19 @@ namespace math_lib {
         static double square_root(double x);
         static double power(double base, double exponent);
         static double absolute(double x);
+
+        // Batch variants: out[i] = op(a[i], b[i]) for i < n.
+        // Same semantics as the scalar functions (x / 0 -> 0, sqrt(x < 0) -> 0),
+        // but no logging. Uses AVX2 or NEON kernels when the CPU supports them.
+        static void add_batch(const double* a, const double* b, double* out, size_t n);
+        static void subtract_batch(const double* a, const double* b, double* out, size_t n);
+        static void multiply_batch(const double* a, const double* b, double* out, size_t n);
+        static void divide_batch(const double* a, const double* b, double* out, size_t n);
+        static void power_batch(const double* base, const double* exponent, double* out, size_t n);
+        static void square_root_batch(const double* x, double* out, size_t n);
+        static void absolute_batch(const double* x, double* out, size_t n);
+
+        // Name of the kernel set picked at startup ("avx2", "neon" or "scalar")
+        static const char* simd_backend();
     };
-} 
\ No newline at end of file
+}
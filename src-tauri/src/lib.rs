@@ -1,109 +1,87 @@
+use pyo3::exceptions::PyRuntimeError;
 use pyo3::prelude::*;
+use pyo3::types::PyModule;
+use std::sync::{Arc, OnceLock, RwLock};
+use std::time::Duration;
+use tauri::ipc::{InvokeBody, Request, Response};
 use tauri::AppHandle;
+use tauri::Emitter;
 use tauri::Manager;
+use tauri::State;
 
+// Yerel C++ görüntü işleme: ham görüntü baytları gelir, ham JPEG baytları döner.
+// İş tokio worker'ı bloklamadan yürütülür; GIL olmadığı için istekler çekirdek
+// sayısı kadar paralel çalışır.
 #[tauri::command]
-async fn process_image(_app_handle: AppHandle, image_data: String) -> Result<String, String> {
-	println!("Rust: Starting Python image processing");
-    
-    // Get the resource directory path outside of the Python context
-    let python_scripts_dir = _app_handle
+async fn process_image(request: Request<'_>) -> Result<Response, String> {
+    let InvokeBody::Raw(image_data) = request.body() else {
+        return Err("Expected raw image bytes".to_string());
+    };
+
+    let jpeg = tokio::task::block_in_place(|| ffi::process_image_native(image_data))
+        .map_err(|e| e.to_string())?;
+    Ok(Response::new(jpeg))
+}
+
+// python_scripts/hello modülü ilk kullanımda bir kez import edilir; sys.path
+// her çağrıda uzatılmaz ve modülün önbellekleri çağrılar arasında yaşar
+static HELLO_MODULE: OnceLock<Py<PyModule>> = OnceLock::new();
+
+fn hello_module<'py>(py: Python<'py>, app_handle: &AppHandle) -> PyResult<&'py PyModule> {
+    if let Some(module) = HELLO_MODULE.get() {
+        return Ok(module.as_ref(py));
+    }
+
+    let python_scripts_dir = app_handle
         .path()
         .resource_dir()
-        .map_err(|e| e.to_string())?
+        .map_err(|e| PyRuntimeError::new_err(e.to_string()))?
         .join("python_scripts");
-    
-    let python_scripts_str = python_scripts_dir.to_str().ok_or("Failed to convert path to string")?;
-    
-    match Python::with_gil(|py| -> PyResult<String> {
-        // Add python_scripts directory to Python path
-        let sys = py.import("sys")?;
-        sys.getattr("path")?.call_method1("append", (python_scripts_str,))?;
-        
-        let module = py.import("hello")?;
-        let result: String = module
-            .getattr("process_image")?
-            .call1((image_data,))?
-            .extract()?;
-        Ok(result)
-    }) {
-        Ok(result) => Ok(result),
-        Err(e) => Err(e.to_string())
-    }
+    let python_scripts_str = python_scripts_dir
+        .to_str()
+        .ok_or_else(|| PyRuntimeError::new_err("Failed to convert path to string"))?;
+    println!("Python scripts path: {}", python_scripts_str);
+
+    let sys = py.import("sys")?;
+    sys.getattr("path")?.call_method1("append", (python_scripts_str,))?;
+    let module: Py<PyModule> = py.import("hello")?.into();
+    // Eşzamanlı ilk çağrılarda import sys.modules'tan aynı nesneyi verir
+    let _ = HELLO_MODULE.set(module);
+    Ok(HELLO_MODULE.get().expect("hello module is set").as_ref(py))
 }
 
 #[tauri::command]
 async fn calculate(_app_handle: AppHandle, operation: String, a: f64, b: f64) -> Result<String, String> {
 	println!("Rust: Starting Python calculator with {} {} {}", operation, a, b);
-    
-    // Get the resource directory path outside of the Python context
-    let python_scripts_dir = _app_handle
-        .path()
-        .resource_dir()
-        .map_err(|e| e.to_string())?
-        .join("python_scripts");
-    
-    let python_scripts_str = python_scripts_dir.to_str().ok_or("Failed to convert path to string")?;
-    
-    match Python::with_gil(|py| -> PyResult<String> {
-        // Add python_scripts directory to Python path
-        let sys = py.import("sys")?;
-        sys.getattr("path")?.call_method1("append", (python_scripts_str,))?;
-        
-        let module = py.import("hello")?;
-        let result: String = module
+
+    Python::with_gil(|py| -> PyResult<String> {
+        let result: String = hello_module(py, &_app_handle)?
             .getattr("calculate")?
             .call1((operation, a, b))?
             .extract()?;
         Ok(result)
-    }) {
-        Ok(result) => Ok(result),
-        Err(e) => Err(e.to_string())
-    }
+    })
+    .map_err(|e| e.to_string())
 }
 
+// MIF çözümü Python'daki mif paketinde kalır (biçim bu depoda tanımlı değil).
+// Açılmış dosyalar ve render edilmiş katmanlar hello.py'de LRU önbellekte
+// tutulur; aynı dosyada katman değiştirmek yeniden ayrıştırma gerektirmez.
+// Python işi tokio worker'ını bloklamadan yürür.
 #[tauri::command]
 async fn mif_reader(app_handle: AppHandle, file_path: String, layer_index: i32, variant_index: i32, scale: i32) -> Result<String, String> {
     println!("Rust: Starting MIF reader with file: {}", file_path);
-    
-    // Get the resource directory path outside of the Python context
-    let python_scripts_dir = app_handle
-        .path()
-        .resource_dir()
-        .map_err(|e| e.to_string())?
-        .join("python_scripts");
-    
-    let python_scripts_str = python_scripts_dir.to_str().ok_or("Failed to convert path to string")?;
-    println!("Python scripts path: {}", python_scripts_str);
-    
-    match Python::with_gil(|py| -> PyResult<String> {
-        // Print Python's sys.path for debugging
-        let sys = py.import("sys")?;
-        println!("Python sys.path before:");
-        let path = sys.getattr("path")?.extract::<Vec<String>>()?;
-        for p in path.iter() {
-            println!("  {}", p);
-        }
-        
-        // Add python_scripts directory to Python path
-        sys.getattr("path")?.call_method1("append", (python_scripts_str,))?;
-        
-        println!("Python sys.path after:");
-        let path = sys.getattr("path")?.extract::<Vec<String>>()?;
-        for p in path.iter() {
-            println!("  {}", p);
-        }
-        
-        let module = py.import("hello")?;
-        let result: String = module
-            .getattr("mif_reader")?
-            .call1((file_path, layer_index, variant_index, scale))?
-            .extract()?;
-        Ok(result)
-    }) {
-        Ok(result) => Ok(result),
-        Err(e) => Err(e.to_string())
-    }
+
+    tokio::task::block_in_place(|| {
+        Python::with_gil(|py| -> PyResult<String> {
+            let result: String = hello_module(py, &app_handle)?
+                .getattr("mif_reader")?
+                .call1((file_path, layer_index, variant_index, scale))?
+                .extract()?;
+            Ok(result)
+        })
+    })
+    .map_err(|e| e.to_string())
 }
 
 #[cxx::bridge]
@@ -116,9 +94,311 @@ pub mod ffi {
         pub fn subtract(a: f64, b: f64) -> f64;
         pub fn multiply(a: f64, b: f64) -> f64;
         pub fn divide(a: f64, b: f64) -> f64;
+        pub fn calculate_batch(operation: &str, a: &[f64], b: &[f64], out: &mut [f64]) -> Result<()>;
+    }
+
+    unsafe extern "C++" {
+        include!("tauri-test/cpp/image_ops.h");
+
+        pub fn process_image_native(encoded: &[u8]) -> Result<Vec<u8>>;
+    }
+
+    unsafe extern "C++" {
+        include!("tauri-test/cpp/color_bridge.h");
+
+        type ColorBridge;
+
+        pub fn new_color_bridge(rgb_profile: &str, cmyk_profile: &str) -> Result<UniquePtr<ColorBridge>>;
+        pub fn set_thread_count(self: Pin<&mut ColorBridge>, count: u32);
+        pub fn convert_rgb8_to_cmyk16(self: &ColorBridge, rgb: &[u8], cmyk: &mut [u16]) -> Result<()>;
+        pub fn convert_rgba8_to_cmyk16(self: &ColorBridge, rgba: &[u8], cmyk: &mut [u16]) -> Result<()>;
+        pub fn convert_rgb16_to_cmyk16(self: &ColorBridge, rgb: &[u16], cmyk: &mut [u16]) -> Result<()>;
+        pub fn convert_rgba8_to_cmyk16_bytes(self: &ColorBridge, rgba: &[u8], cmyk: &mut [u8]) -> Result<()>;
+        pub fn convert_rgba8_to_cmyk16_region(
+            self: &ColorBridge,
+            rgba: &[u8],
+            cmyk: &mut [u16],
+            width: u32,
+            height: u32,
+            x: u32,
+            y: u32,
+            region_width: u32,
+            region_height: u32,
+        ) -> Result<()>;
+
+        type SoftProofBridge;
+
+        pub fn new_soft_proof_bridge(
+            rgb_profile: &str,
+            cmyk_profile: &str,
+            display_profile: &str,
+        ) -> Result<UniquePtr<SoftProofBridge>>;
+        pub fn set_image(self: Pin<&mut SoftProofBridge>, rgba: &[u8], width: u32, height: u32) -> Result<()>;
+        pub fn level_count(self: &SoftProofBridge) -> u32;
+        pub fn preview_level(
+            self: &SoftProofBridge,
+            x: u32,
+            y: u32,
+            width: u32,
+            height: u32,
+            target_width: u32,
+            target_height: u32,
+        ) -> u32;
+        pub fn final_level(
+            self: &SoftProofBridge,
+            x: u32,
+            y: u32,
+            width: u32,
+            height: u32,
+            target_width: u32,
+            target_height: u32,
+        ) -> u32;
+        pub fn begin_view(self: &SoftProofBridge) -> u64;
+        pub fn frame_size(self: &SoftProofBridge, level: u32, x: u32, y: u32, width: u32, height: u32) -> usize;
+        pub fn render(
+            self: &SoftProofBridge,
+            level: u32,
+            x: u32,
+            y: u32,
+            width: u32,
+            height: u32,
+            generation: u64,
+            out: &mut [u8],
+        ) -> Result<bool>;
+
+        type ConversionJobsBridge;
+
+        pub fn new_conversion_jobs_bridge(concurrent: u32) -> UniquePtr<ConversionJobsBridge>;
+        pub fn submit_image(
+            self: &ConversionJobsBridge,
+            input_path: &str,
+            output_path: &str,
+            rgb_profile: &str,
+            cmyk_profile: &str,
+            threads: u32,
+            pyramid: bool,
+        ) -> u64;
+        pub fn job_state(self: &ConversionJobsBridge, id: u64) -> Result<u8>;
+        pub fn job_rows_done(self: &ConversionJobsBridge, id: u64) -> Result<u32>;
+        pub fn job_total_rows(self: &ConversionJobsBridge, id: u64) -> Result<u32>;
+        pub fn cancel_job(self: &ConversionJobsBridge, id: u64) -> bool;
+        pub fn wait_job(self: &ConversionJobsBridge, id: u64) -> Result<()>;
+        pub fn forget_job(self: &ConversionJobsBridge, id: u64);
     }
 }
 
+// ColorBridge'in dönüşüm metotları const ve thread-safe'tir; dönüşümler
+// kilit tutulmadan paylaşılan Arc üzerinden paralel yürür
+unsafe impl Send for ffi::ColorBridge {}
+unsafe impl Sync for ffi::ColorBridge {}
+
+#[derive(Default)]
+struct ColorState(RwLock<Option<Arc<cxx::UniquePtr<ffi::ColorBridge>>>>);
+
+#[tauri::command]
+async fn color_init(state: State<'_, ColorState>, rgb_profile: String, cmyk_profile: String) -> Result<(), String> {
+    let mut bridge = ffi::new_color_bridge(&rgb_profile, &cmyk_profile).map_err(|e| e.to_string())?;
+    // Tüm çekirdekleri kullan
+    bridge.pin_mut().set_thread_count(0);
+    *state.0.write().map_err(|e| e.to_string())? = Some(Arc::new(bridge));
+    Ok(())
+}
+
+// Ham RGBA8 baytlarını alır, ham CMYK16 baytları döner; base64/JSON yok
+#[tauri::command]
+async fn color_convert(state: State<'_, ColorState>, request: Request<'_>) -> Result<Response, String> {
+    let InvokeBody::Raw(rgba) = request.body() else {
+        return Err("Expected raw RGBA8 body".to_string());
+    };
+
+    // Kilit yalnızca Arc kopyalanırken tutulur; süren dönüşüm color_init'i
+    // bekletmez, eski köprü son dönüşüm bitince serbest kalır
+    let bridge = state
+        .0
+        .read()
+        .map_err(|e| e.to_string())?
+        .clone()
+        .ok_or("Color converter is not initialized")?;
+
+    let mut cmyk = vec![0u8; rgba.len() / 4 * 8];
+    tokio::task::block_in_place(|| bridge.convert_rgba8_to_cmyk16_bytes(rgba, &mut cmyk))
+        .map_err(|e| e.to_string())?;
+    Ok(Response::new(cmyk))
+}
+
+// SoftProofBridge'in const metotları thread-safe'tir; render'lar okuma
+// kilidiyle paralel yürür, yeni bir görünüm süren render'ları keser
+unsafe impl Send for ffi::SoftProofBridge {}
+unsafe impl Sync for ffi::SoftProofBridge {}
+
+#[derive(Default)]
+struct ProofState(RwLock<Option<cxx::UniquePtr<ffi::SoftProofBridge>>>);
+
+#[derive(serde::Serialize)]
+struct ProofViewInfo {
+    generation: u64,
+    preview_level: u32,
+    final_level: u32,
+}
+
+#[tauri::command]
+async fn proof_init(
+    state: State<'_, ProofState>,
+    rgb_profile: String,
+    cmyk_profile: String,
+    display_profile: Option<String>,
+) -> Result<(), String> {
+    let bridge = ffi::new_soft_proof_bridge(&rgb_profile, &cmyk_profile, display_profile.as_deref().unwrap_or(""))
+        .map_err(|e| e.to_string())?;
+    *state.0.write().map_err(|e| e.to_string())? = Some(bridge);
+    Ok(())
+}
+
+// Ham RGBA8 gövdesi; boyutlar x-width / x-height başlıklarında
+#[tauri::command]
+async fn proof_set_image(state: State<'_, ProofState>, request: Request<'_>) -> Result<u32, String> {
+    let InvokeBody::Raw(rgba) = request.body() else {
+        return Err("Expected raw RGBA8 body".to_string());
+    };
+    let dimension = |name: &str| -> Result<u32, String> {
+        request
+            .headers()
+            .get(name)
+            .and_then(|v| v.to_str().ok())
+            .and_then(|v| v.parse().ok())
+            .ok_or(format!("Missing or invalid {} header", name))
+    };
+    let (width, height) = (dimension("x-width")?, dimension("x-height")?);
+
+    let mut guard = state.0.write().map_err(|e| e.to_string())?;
+    let bridge = guard.as_mut().ok_or("Soft proof is not initialized")?;
+    tokio::task::block_in_place(|| bridge.pin_mut().set_image(rgba, width, height)).map_err(|e| e.to_string())?;
+    Ok(bridge.level_count())
+}
+
+// Yeni görünüm: önceki render'lar iptal edilir; arayüz preview_level'den
+// final_level'e doğru proof_render çağırır
+#[tauri::command]
+fn proof_view(
+    state: State<'_, ProofState>,
+    x: u32,
+    y: u32,
+    width: u32,
+    height: u32,
+    target_width: u32,
+    target_height: u32,
+) -> Result<ProofViewInfo, String> {
+    let guard = state.0.read().map_err(|e| e.to_string())?;
+    let bridge = guard.as_ref().ok_or("Soft proof is not initialized")?;
+    Ok(ProofViewInfo {
+        generation: bridge.begin_view(),
+        preview_level: bridge.preview_level(x, y, width, height, target_width, target_height),
+        final_level: bridge.final_level(x, y, width, height, target_width, target_height),
+    })
+}
+
+// Ham yanıt: 16 baytlık bölge başlığı + RGBA8; iptal edildiyse boş
+#[tauri::command]
+async fn proof_render(
+    state: State<'_, ProofState>,
+    level: u32,
+    x: u32,
+    y: u32,
+    width: u32,
+    height: u32,
+    generation: u64,
+) -> Result<Response, String> {
+    let guard = state.0.read().map_err(|e| e.to_string())?;
+    let bridge = guard.as_ref().ok_or("Soft proof is not initialized")?;
+
+    let mut frame = vec![0u8; bridge.frame_size(level, x, y, width, height)];
+    let done = tokio::task::block_in_place(|| bridge.render(level, x, y, width, height, generation, &mut frame))
+        .map_err(|e| e.to_string())?;
+    if !done {
+        frame.clear();
+    }
+    Ok(Response::new(frame))
+}
+
+// ConversionJobsBridge'in tüm metotları const ve thread-safe'tir
+unsafe impl Send for ffi::ConversionJobsBridge {}
+unsafe impl Sync for ffi::ConversionJobsBridge {}
+
+struct JobsState(Arc<cxx::UniquePtr<ffi::ConversionJobsBridge>>);
+
+impl Default for JobsState {
+    fn default() -> Self {
+        // Aynı anda tek iş; her iş tüm çekirdekleri kullanır
+        JobsState(Arc::new(ffi::new_conversion_jobs_bridge(1)))
+    }
+}
+
+// ConversionJob::state sırası; bundan büyük ya da eşit durumlar bitmiştir
+const JOB_SUCCEEDED: u8 = 2;
+
+#[derive(Clone, serde::Serialize)]
+struct ConvertProgress {
+    id: u64,
+    rows_done: u32,
+    total_rows: u32,
+    state: u8,
+}
+
+// Dosya dönüşümünü kuyruğa alır ve hemen iş kimliğini döner; iptal için
+// convert_image_cancel, sonuç için convert_image_wait. pyramid ile çıktı,
+// görüntüleyicinin yakınlaştırmaya göre tile okuyabileceği piramitli TIFF'tir.
+#[tauri::command]
+fn convert_image_start(
+    state: State<'_, JobsState>,
+    input_path: String,
+    output_path: String,
+    rgb_profile: String,
+    cmyk_profile: String,
+    pyramid: Option<bool>,
+) -> u64 {
+    state
+        .0
+        .submit_image(&input_path, &output_path, &rgb_profile, &cmyk_profile, 0, pyramid.unwrap_or(false))
+}
+
+// İş bitene kadar "convert-progress" olayları yayınlar ve sonucu döner.
+// Command thread'i bloklanmaz: durum C++ tarafındaki atomiklerden okunur,
+// aralarda tokio uyur. Son olay bitiş durumunu taşır; ardından kayıt bırakılır.
+#[tauri::command]
+async fn convert_image_wait(app: AppHandle, state: State<'_, JobsState>, id: u64) -> Result<(), String> {
+    let jobs = state.0.clone();
+    let mut last: Option<ConvertProgress> = None;
+    loop {
+        let current = ConvertProgress {
+            id,
+            rows_done: jobs.job_rows_done(id).map_err(|e| e.to_string())?,
+            total_rows: jobs.job_total_rows(id).map_err(|e| e.to_string())?,
+            state: jobs.job_state(id).map_err(|e| e.to_string())?,
+        };
+        let changed = last
+            .as_ref()
+            .map_or(true, |l| l.rows_done != current.rows_done || l.state != current.state);
+        if changed {
+            let _ = app.emit("convert-progress", current.clone());
+        }
+        if current.state >= JOB_SUCCEEDED {
+            break;
+        }
+        last = Some(current);
+        tokio::time::sleep(Duration::from_millis(100)).await;
+    }
+
+    // İş bitti; wait_job bloklamadan hata veya iptali bildirir
+    let result = jobs.wait_job(id).map_err(|e| e.to_string());
+    jobs.forget_job(id);
+    result
+}
+
+#[tauri::command]
+fn convert_image_cancel(state: State<'_, JobsState>, id: u64) -> bool {
+    state.0.cancel_job(id)
+}
+
 #[tauri::command]
 fn call_cpp_hello() {
     ffi::say_hello();
@@ -141,6 +421,15 @@ fn cpp_calculate(operation: &str, a: f64, b: f64) -> Result<f64, String> {
     }
 }
 
+// Toplu hesaplama: tek IPC + tek FFI çağrısıyla tüm dizi işlenir
+#[tauri::command]
+fn cpp_calculate_batch(operation: &str, a: Vec<f64>, b: Vec<f64>) -> Result<Vec<f64>, String> {
+    println!("Rust: cpp_calculate_batch {} on {} values", operation, a.len());
+    let mut out = vec![0.0; a.len()];
+    ffi::calculate_batch(operation, &a, &b, &mut out).map_err(|e| e.to_string())?;
+    Ok(out)
+}
+
 #[tauri::command]
 fn process_file() -> String {
     "success".to_string()
@@ -153,6 +442,9 @@ fn show_alert() -> String {
 
 pub fn run() {
     tauri::Builder::default()
+        .manage(ColorState::default())
+        .manage(ProofState::default())
+        .manage(JobsState::default())
         .plugin(tauri_plugin_os::init())
         .plugin(tauri_plugin_opener::init())
         .plugin(tauri_plugin_dialog::init())
@@ -164,7 +456,17 @@ pub fn run() {
             call_cpp_hello,
             process_file,
             show_alert,
-            cpp_calculate
+            cpp_calculate,
+            cpp_calculate_batch,
+            color_init,
+            color_convert,
+            proof_init,
+            proof_set_image,
+            proof_view,
+            proof_render,
+            convert_image_start,
+            convert_image_wait,
+            convert_image_cancel
         ])
         .run(tauri::generate_context!())
         .expect("error while running tauri application");
@@ -0,0 +1,214 @@
+#include "color/BatchConverter.hpp"
+#include "color/ThreadPool.hpp"
+#include "stb_image.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+    // Varsayılan toplam bütçe: 1 GB
+    constexpr size_t kDefaultBatchBudget = 1024u * 1024 * 1024;
+
+    // Worker başına şerit bütçesi sınırları
+    constexpr size_t kMinStripBudget = 4u * 1024 * 1024;
+    constexpr size_t kMaxStripBudget = 64u * 1024 * 1024;
+
+    using Clock = std::chrono::steady_clock;
+
+    bool isSupportedImage(const std::filesystem::path& path) {
+        std::string ext = path.extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        static const char* const kExtensions[] = {
+            ".png", ".jpg", ".jpeg", ".bmp", ".tga", ".gif", ".psd", ".pnm", ".ppm", ".pgm"
+        };
+        for (const char* known : kExtensions) {
+            if (ext == known) return true;
+        }
+        return false;
+    }
+
+    // Dolaşımdaki dosyaların tahmini bellek toplamını sınırlar
+    class MemoryGate {
+    public:
+        explicit MemoryGate(size_t budget) : budget(budget), inFlight(0), active(0) {}
+
+        void acquire(size_t bytes) {
+            std::unique_lock<std::mutex> lock(mutex);
+            // Bütçeden büyük tek dosya, boşta iken yine de çalışabilmeli
+            cv.wait(lock, [&] { return active == 0 || inFlight + bytes <= budget; });
+            inFlight += bytes;
+            ++active;
+        }
+
+        void release(size_t bytes) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                inFlight -= bytes;
+                --active;
+            }
+            cv.notify_all();
+        }
+
+    private:
+        const size_t budget;
+        size_t inFlight;
+        size_t active;
+        std::mutex mutex;
+        std::condition_variable cv;
+    };
+}
+
+BatchConverter::BatchConverter()
+    : initialized(false), parallelFiles(ThreadPool::hardwareThreads()), memoryBudget(kDefaultBatchBudget) {}
+
+bool BatchConverter::initialize(const std::string& rgbProfilePath,
+                                const std::string& cmykProfilePath,
+                                const ConversionOptions& conversionOptions) {
+    // Profiller, transform ve (lutGridPoints verildiyse) LUT burada bir kez
+    // oluşturulur; worker'lar bu converter'dan başlatılır, dosya sistemine
+    // tekrar gidilmez ve LUT yeniden pişirilmez
+    initialized = prototype.initialize(rgbProfilePath, cmykProfilePath, conversionOptions);
+    return initialized;
+}
+
+void BatchConverter::setParallelFiles(unsigned count) {
+    parallelFiles = count ? count : ThreadPool::hardwareThreads();
+}
+
+void BatchConverter::setMemoryBudget(size_t bytes) {
+    memoryBudget = bytes ? bytes : kDefaultBatchBudget;
+}
+
+BatchSummary BatchConverter::run(const std::vector<BatchItem>& items, const ResultCallback& onResult) {
+    BatchSummary summary;
+    if (items.empty()) return summary;
+    if (!initialized) {
+        std::cerr << "BatchConverter başlatılmamış!" << std::endl;
+        summary.failed = items.size();
+        return summary;
+    }
+
+    const Clock::time_point started = Clock::now();
+    const unsigned workers = static_cast<unsigned>(std::min<size_t>(parallelFiles, items.size()));
+
+    // Bütçenin bir kısmı şerit buffer'larına, kalanı çözülmüş görüntülere
+    const size_t stripBudget = std::min(std::max(memoryBudget / (4 * workers), kMinStripBudget),
+                                        kMaxStripBudget);
+
+    // Aynı çıktıya yazan paralel worker'lar birbirinin dosyasını silebilir;
+    // çıktısı önceki bir öğeyle çakışan öğe dönüştürülmeden başarısız olur
+    std::vector<bool> duplicate(items.size(), false);
+    {
+        std::unordered_set<std::string> outputs;
+        for (size_t i = 0; i < items.size(); ++i) {
+            const std::string output = std::filesystem::path(items[i].outputPath).lexically_normal().string();
+            duplicate[i] = !outputs.insert(output).second;
+        }
+    }
+
+    MemoryGate gate(memoryBudget);
+    std::atomic<size_t> next(0);
+    std::mutex resultMutex;
+
+    auto worker = [&] {
+        ImageColorConverter converter;
+        const bool ready = converter.initialize(prototype);
+        converter.setVerbose(false);
+        converter.setMemoryBudget(stripBudget);
+        // Worker'ın arenası dosyalar arasında en fazla bütçe payını tutar
+        converter.scratchArena().setRetainLimit(memoryBudget / workers);
+        // Paralellik dosyalar arasında; dosya içi transform tek thread
+        converter.colorConverter().setThreadCount(1);
+
+        for (size_t index = next++; index < items.size(); index = next++) {
+            const BatchItem& item = items[index];
+            BatchResult result;
+            result.index = index;
+            result.inputPath = item.inputPath;
+            result.outputPath = item.outputPath;
+
+            int width = 0, height = 0, channels = 0;
+            size_t estimate = 0;
+            if (stbi_info(item.inputPath.c_str(), &width, &height, &channels)) {
+                const size_t pixels = static_cast<size_t>(width) * height;
+                estimate = pixels * sizeof(RGB8) + std::min(stripBudget, pixels * sizeof(CMYK16));
+            }
+
+            Clock::time_point t = Clock::now();
+            if (!ready) {
+                result.error = "Converter başlatılamadı";
+            } else if (duplicate[index]) {
+                result.error = "Çıktı dosyası başka bir girdiyle aynı: " + item.outputPath;
+            } else {
+                gate.acquire(estimate);
+                result.success = converter.convertImage(item.inputPath, item.outputPath);
+                gate.release(estimate);
+                if (!result.success) result.error = converter.lastError();
+                result.stats = converter.lastPipelineStats();
+            }
+            result.seconds = std::chrono::duration<double>(Clock::now() - t).count();
+
+            std::lock_guard<std::mutex> lock(resultMutex);
+            if (result.success) ++summary.succeeded;
+            else ++summary.failed;
+            if (onResult) onResult(result);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < workers; ++i) threads.emplace_back(worker);
+    worker();
+    for (std::thread& thread : threads) thread.join();
+
+    summary.wallSeconds = std::chrono::duration<double>(Clock::now() - started).count();
+    return summary;
+}
+
+BatchItem BatchConverter::itemFor(const std::string& inputPath, const std::string& outputDirectory) {
+    std::filesystem::path input(inputPath);
+    std::filesystem::path output = outputDirectory.empty()
+        ? input
+        : std::filesystem::path(outputDirectory) / input.filename();
+    output.replace_extension(".tiff");
+    return BatchItem{inputPath, output.string()};
+}
+
+std::vector<BatchItem> BatchConverter::fromDirectory(const std::string& inputDirectory,
+                                                     const std::string& outputDirectory) {
+    std::vector<BatchItem> items;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(inputDirectory, ec)) {
+        if (entry.is_regular_file(ec) && isSupportedImage(entry.path())) {
+            items.push_back(itemFor(entry.path().string(),
+                                    outputDirectory.empty() ? inputDirectory : outputDirectory));
+        }
+    }
+    if (ec) std::cerr << "Dizin okunamadı: " << inputDirectory << std::endl;
+
+    // logo.png ve logo.jpg aynı logo.tiff'e düşmesin: çakışan adlar
+    // uzantıyı da taşır (logo_png.tiff, logo_jpg.tiff)
+    std::unordered_map<std::string, size_t> uses;
+    for (const BatchItem& item : items) ++uses[item.outputPath];
+    for (BatchItem& item : items) {
+        if (uses[item.outputPath] < 2) continue;
+        const std::filesystem::path input(item.inputPath);
+        std::filesystem::path output(item.outputPath);
+        output.replace_filename(input.stem().string() + "_" + input.extension().string().substr(1) + ".tiff");
+        item.outputPath = output.string();
+    }
+
+    std::sort(items.begin(), items.end(),
+              [](const BatchItem& a, const BatchItem& b) { return a.inputPath < b.inputPath; });
+    return items;
+}
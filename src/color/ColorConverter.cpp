@@ -1,55 +1,514 @@
 #include "color/ColorConverter.hpp"
+#include "color/LutDiskCache.hpp"
+#include "color/PixelDescriptor.hpp"
+#include "color/ThreadPool.hpp"
+#include "color/TransformCache.hpp"
+#include "color/UniqueColorCache.hpp"
+#include <algorithm>
+#include <cstring>
+#include <functional>
 #include <iostream>
 
+namespace {
+    // Parça başına ~16K piksel: 16-bit RGB girdi + CMYK çıktı ~224 KB, L2'ye sığar
+    constexpr size_t kDefaultChunkPixels = 16 * 1024;
+
+    // Renk cache'inin kurulmasına değecek en küçük girdi
+    constexpr size_t kUniqueColorMinPixels = 64 * 1024;
+
+    // Düzlemler eşit aralıklı değilse lcms bu boyutta bir ara buffer'a yazar
+    constexpr size_t kPlanarScratchPixels = 1024;
+
+    bool isRGB(PixelFormat format) {
+        return format == PixelFormat::RGB8 || format == PixelFormat::RGBA8 ||
+               format == PixelFormat::RGB16;
+    }
+}
+
 ColorConverter::ColorConverter() 
-    : hInProfile(nullptr), hOutProfile(nullptr), hTransform(nullptr) {}
+    : instr(new Instrumentation()), ready(false), threadCount(1), chunkPixels(kDefaultChunkPixels) {
+    for (auto& byInput : publishedTransforms)
+        for (auto& byOutput : byInput)
+            for (auto& slot : byOutput) slot.store(nullptr, std::memory_order_relaxed);
+}
+
+// Profil ve transform'lar paylaşılan cache'e aittir; son referansla serbest kalır
+ColorConverter::~ColorConverter() = default;
+
+ColorConverter::ColorConverter(ColorConverter&& other) : ColorConverter() {
+    swap(other);
+}
+
+ColorConverter& ColorConverter::operator=(ColorConverter&& other) {
+    if (this != &other) {
+        ColorConverter taken(std::move(other));
+        swap(taken);
+    }
+    return *this;
+}
+
+void ColorConverter::swap(ColorConverter& other) {
+    std::scoped_lock lock(transformMutex, other.transformMutex);
+    std::swap(options, other.options);
+    std::swap(instr, other.instr);
+    std::swap(inProfile, other.inProfile);
+    std::swap(outProfile, other.outProfile);
+    std::swap(transforms, other.transforms);
+    for (size_t i = 0; i < kFormatCount; ++i) {
+        for (size_t o = 0; o < kFormatCount; ++o) {
+            for (size_t p = 0; p < 2; ++p) {
+                cmsHTRANSFORM mine = publishedTransforms[i][o][p].load(std::memory_order_relaxed);
+                publishedTransforms[i][o][p].store(
+                    other.publishedTransforms[i][o][p].load(std::memory_order_relaxed), std::memory_order_relaxed);
+                other.publishedTransforms[i][o][p].store(mine, std::memory_order_relaxed);
+            }
+        }
+    }
+    std::swap(ready, other.ready);
+    std::swap(lut, other.lut);
+    std::swap(threadCount, other.threadCount);
+    std::swap(chunkPixels, other.chunkPixels);
+    std::swap(pool, other.pool);
+}
 
-ColorConverter::~ColorConverter() {
-    if (hTransform) cmsDeleteTransform(hTransform);
-    if (hInProfile) cmsCloseProfile(hInProfile);
-    if (hOutProfile) cmsCloseProfile(hOutProfile);
+void ColorConverter::clearTransforms() {
+    std::lock_guard<std::mutex> lock(transformMutex);
+    for (auto& byInput : publishedTransforms)
+        for (auto& byOutput : byInput)
+            for (auto& slot : byOutput) slot.store(nullptr, std::memory_order_relaxed);
+    transforms.clear();
 }
 
 bool ColorConverter::initialize(const std::string& rgbProfilePath, 
                               const std::string& cmykProfilePath) {
-    hInProfile = cmsOpenProfileFromFile(rgbProfilePath.c_str(), "r");
-    if (!hInProfile) {
+    return initialize(rgbProfilePath, cmykProfilePath, ConversionOptions());
+}
+
+bool ColorConverter::initialize(const std::string& rgbProfilePath,
+                                const std::string& cmykProfilePath,
+                                const ConversionOptions& conversionOptions) {
+    ready = false;
+    TransformCache& cache = TransformCache::instance();
+
+    CachedProfile rgbProfile;
+    {
+        Instrumentation::Scope scope(*instr, Stage::ProfileOpen);
+        rgbProfile = cache.openProfile(rgbProfilePath);
+    }
+    if (!rgbProfile) {
         std::cerr << "RGB profili yüklenemedi: " << rgbProfilePath << std::endl;
         return false;
     }
 
-    hOutProfile = cmsOpenProfileFromFile(cmykProfilePath.c_str(), "r");
-    if (!hOutProfile) {
+    CachedProfile cmykProfile;
+    {
+        Instrumentation::Scope scope(*instr, Stage::ProfileOpen);
+        cmykProfile = cache.openProfile(cmykProfilePath);
+    }
+    if (!cmykProfile) {
         std::cerr << "CMYK profili yüklenemedi: " << cmykProfilePath << std::endl;
         return false;
     }
 
-    hTransform = cmsCreateTransform(
-        hInProfile,
-        TYPE_RGB_16,        // 16-bit RGB
-        hOutProfile,
-        TYPE_CMYK_16,       // 16-bit CMYK
-        INTENT_PERCEPTUAL,
-        cmsFLAGS_BLACKPOINTCOMPENSATION | 
-        cmsFLAGS_HIGHRESPRECALC    // Yüksek hassasiyet için
-    );
+    return initialize(rgbProfile, cmykProfile, conversionOptions);
+}
+
+bool ColorConverter::initialize(const CachedProfile& rgbProfile,
+                                const CachedProfile& cmykProfile,
+                                const ConversionOptions& conversionOptions) {
+    options = conversionOptions;
+    // Transform'lar thread'ler ve converter'lar arasında paylaşılır; lcms'in
+    // tek piksellik cache'i paylaşımda yarışır, bayrak her zaman eklenir
+    options.flags |= cmsFLAGS_NOCACHE;
+    ready = false;
+    if (!rgbProfile || !cmykProfile) {
+        std::cerr << "Profil açılmamış!" << std::endl;
+        return false;
+    }
+    inProfile = rgbProfile;
+    outProfile = cmykProfile;
+
+    clearTransforms();
+    lut.reset();
+
+    if (options.lutGridPoints) {
+        if (!initializeLut()) return false;
+    } else if (!transformFor(PixelFormat::RGB16, PixelFormat::CMYK16)) {
+        // Varsayılan 16-bit transform'u şimdi oluştur ki hatalar initialize'da görünsün
+        std::cerr << "Transform oluşturulamadı!" << std::endl;
+        return false;
+    }
+
+    ready = true;
+    return true;
+}
+
+bool ColorConverter::initialize(const ColorConverter& source) {
+    ready = false;
+    if (!source.ready) {
+        std::cerr << "Kaynak converter başlatılmamış!" << std::endl;
+        return false;
+    }
+    options = source.options;
+    inProfile = source.inProfile;
+    outProfile = source.outProfile;
+
+    clearTransforms();
+    // LUT salt okunurdur; converter'lar arasında paylaşılır
+    lut = source.lut;
+    if (!lut && !transformFor(PixelFormat::RGB16, PixelFormat::CMYK16)) {
+        std::cerr << "Transform oluşturulamadı!" << std::endl;
+        return false;
+    }
+
+    ready = true;
+    return true;
+}
+
+bool ColorConverter::initializeLut() {
+    LutCacheKey key;
+    key.input = inProfile.id;
+    key.output = outProfile.id;
+    key.intent = options.intent;
+    key.flags = options.flags;
+    key.gridPoints = options.lutGridPoints;
+
+    // Disk cache'te varsa transform hiç oluşturulmaz; dosya yalnızca eşlenir
+    if (!options.lutCacheDirectory.empty()) {
+        Instrumentation::Scope scope(*instr, Stage::TransformBuild);
+        lut = LutDiskCache(options.lutCacheDirectory).load(key);
+        if (lut) return true;
+    }
 
-    if (!hTransform) {
+    cmsHTRANSFORM reference = transformFor(PixelFormat::RGB16, PixelFormat::CMYK16);
+    if (!reference) {
         std::cerr << "Transform oluşturulamadı!" << std::endl;
         return false;
     }
 
+    std::shared_ptr<Lut3D> baked = std::make_shared<Lut3D>();
+    {
+        Instrumentation::Scope scope(*instr, Stage::TransformBuild);
+        if (!baked->build(reference, options.lutGridPoints)) {
+            std::cerr << "3D LUT oluşturulamadı!" << std::endl;
+            return false;
+        }
+    }
+    lut = baked;
+
+    if (!options.lutCacheDirectory.empty() &&
+        !LutDiskCache(options.lutCacheDirectory).store(key, *baked)) {
+        // Cache yazılamazsa dönüşüm yine çalışır, yalnızca sonraki açılış hızlanmaz
+        std::cerr << "LUT cache'e yazılamadı: " << options.lutCacheDirectory << std::endl;
+    }
+    return true;
+}
+
+cmsHTRANSFORM ColorConverter::transformFor(PixelFormat inputFormat, PixelFormat outputFormat,
+                                           bool planarOutput) const {
+    // Sıcak yol: daha önce kurulmuş transform kilitsiz okunur
+    std::atomic<cmsHTRANSFORM>& slot =
+        publishedTransforms[static_cast<size_t>(inputFormat)][static_cast<size_t>(outputFormat)][planarOutput];
+    if (cmsHTRANSFORM published = slot.load(std::memory_order_acquire)) return published;
+
+    std::lock_guard<std::mutex> lock(transformMutex);
+    auto key = std::make_tuple(inputFormat, outputFormat, planarOutput);
+    auto it = transforms.find(key);
+    if (it != transforms.end()) return it->second.get();
+
+    Instrumentation::Scope scope(*instr, Stage::TransformBuild);
+    std::shared_ptr<void> transform = TransformCache::instance().getTransform(
+        inProfile, lcmsFormatOf(inputFormat),
+        outProfile, lcmsFormatOf(outputFormat) | (planarOutput ? PLANAR_SH(1) : 0),
+        options.intent, options.flags, options.useFastFloat);
+    if (!transform) return nullptr;
+
+    transforms[key] = transform;
+    slot.store(transform.get(), std::memory_order_release);
+    return transform.get();
+}
+
+bool ColorConverter::prepare(PixelFormat inputFormat, PixelFormat outputFormat, bool planarOutput,
+                             const Lut3D*& table, cmsHTRANSFORM& transform) const {
+    if (!ready) {
+        std::cerr << "Transform henüz oluşturulmamış!" << std::endl;
+        return false;
+    }
+
+    if (!isRGB(inputFormat) || isRGB(outputFormat)) {
+        std::cerr << "Desteklenmeyen piksel formatı: girdi RGB, çıktı CMYK olmalı" << std::endl;
+        return false;
+    }
+
+    // LUT bu formatları kapsıyorsa lcms transform'u hiç gerekmez
+    table = (lut && Lut3D::supports(inputFormat, outputFormat)) ? lut.get() : nullptr;
+    transform = table ? nullptr : transformFor(inputFormat, outputFormat, planarOutput);
+    if (!table && !transform) {
+        std::cerr << "Transform oluşturulamadı!" << std::endl;
+        return false;
+    }
     return true;
 }
 
 bool ColorConverter::convertRGBtoCMYK(const uint16_t* rgbData, 
                                     uint16_t* cmykData, 
-                                    size_t pixelCount) {
-    if (!hTransform) {
-        std::cerr << "Transform henüz oluşturulmamış!" << std::endl;
+                                    size_t pixelCount) const {
+    return convert(rgbData, PixelFormat::RGB16, cmykData, PixelFormat::CMYK16, pixelCount);
+}
+
+bool ColorConverter::convertRGBtoCMYK(const uint16_t* rgbData, size_t rgbStride,
+                                      uint16_t* cmykData, size_t cmykStride,
+                                      size_t width, size_t height, const PixelRect& region) const {
+    return convert(rgbData, PixelFormat::RGB16, rgbStride,
+                   cmykData, PixelFormat::CMYK16, cmykStride,
+                   width, height, region);
+}
+
+bool ColorConverter::convert(const void* input, PixelFormat inputFormat,
+                             void* output, PixelFormat outputFormat,
+                             size_t pixelCount) const {
+    return convertContiguous(input, inputFormat, output, outputFormat, pixelCount, nullptr, nullptr);
+}
+
+bool ColorConverter::convert(const void* input, PixelFormat inputFormat,
+                             void* output, PixelFormat outputFormat,
+                             size_t pixelCount, const InkOptions& ink, InkStats& stats) const {
+    stats = InkStats();
+    return convertContiguous(input, inputFormat, output, outputFormat, pixelCount, &ink, &stats);
+}
+
+bool ColorConverter::convertContiguous(const void* input, PixelFormat inputFormat,
+                                       void* output, PixelFormat outputFormat, size_t pixelCount,
+                                       const InkOptions* ink, InkStats* stats) const {
+    const Lut3D* table = nullptr;
+    cmsHTRANSFORM h = nullptr;
+    if (!prepare(inputFormat, outputFormat, false, table, h)) return false;
+
+    const size_t inStride = bytesPerPixel(inputFormat);
+    const size_t outStride = bytesPerPixel(outputFormat);
+    Instrumentation::Scope scope(*instr, Stage::TransformExecute);
+    instr->addPixels(pixelCount, pixelCount * inStride, pixelCount * outStride);
+
+    const uint8_t* in = static_cast<const uint8_t*>(input);
+    uint8_t* out = static_cast<uint8_t*>(output);
+
+    auto direct = [&](const uint8_t* from, uint8_t* to, size_t count) {
+        if (table) {
+            table->apply(from, inputFormat, to, outputFormat, count);
+        } else {
+            cmsDoTransform(h, from, to, static_cast<cmsUInt32Number>(count));
+        }
+    };
+
+    // Mürekkep istatistiği her parça yazılır yazılmaz, parça hâlâ önbellekteyken
+    // toplanır; parçaların kısmi sonuçları sonunda birleştirilir
+    std::mutex inkMutex;
+    auto analyse = [&](size_t begin, size_t end, InkStats& part) {
+        if (ink) accumulateInk(out + begin * outStride, outputFormat, end - begin, begin, *ink, part);
+    };
+    auto publish = [&](const InkStats& part) {
+        if (!ink) return;
+        std::lock_guard<std::mutex> lock(inkMutex);
+        stats->merge(part);
+    };
+
+    std::function<void(size_t, size_t)> run = [&](size_t begin, size_t end) {
+        direct(in + begin * inStride, out + begin * outStride, end - begin);
+        if (ink) {
+            InkStats part;
+            analyse(begin, end, part);
+            publish(part);
+        }
+    };
+
+    // Az renkli girdi: her parça kendi renk tablosunu kurar. Parçalar thread
+    // başına bir tane olacak kadar büyütülür ki her renk az sayıda dönüşsün.
+    size_t chunk = chunkPixels;
+    if (options.uniqueColorLimit && pixelCount >= kUniqueColorMinPixels &&
+        UniqueColorCache::looksFlat(input, inputFormat, pixelCount, options.uniqueColorLimit)) {
+        const size_t tasks = pool ? pool->threadCount() + 1 : 1;
+        chunk = std::max(chunkPixels, (pixelCount + tasks - 1) / tasks);
+        run = [&](size_t begin, size_t end) {
+            UniqueColorCache colors(inputFormat, outputFormat, options.uniqueColorLimit, end - begin);
+            const UniqueColorCache::BatchConvert batch = [&](const uint8_t* from, uint8_t* to, size_t count) {
+                direct(from, to, count);
+            };
+            // Tablo tüm görev için ortak; yazım ve istatistik chunkPixels'lik adımlarla
+            InkStats part;
+            for (size_t at = begin; at < end; at += chunkPixels) {
+                const size_t stop = std::min(end, at + chunkPixels);
+                const size_t done = colors.convert(in + at * inStride, out + at * outStride, stop - at, batch);
+                if (at + done < stop) {
+                    // Renk sınırı aşıldı; kalanı doğrudan
+                    direct(in + (at + done) * inStride, out + (at + done) * outStride, stop - at - done);
+                }
+                analyse(at, stop, part);
+            }
+            publish(part);
+        };
+    }
+
+    if (!pool || pixelCount <= chunk) {
+        run(0, pixelCount);
+        return true;
+    }
+
+    // Piksel aralığını parçalara bölüp havuzdaki thread'lere dağıt
+    pool->parallelFor(pixelCount, chunk, run);
+    return true;
+}
+
+bool ColorConverter::convert(const void* input, PixelFormat inputFormat, size_t inputStride,
+                             void* output, PixelFormat outputFormat, size_t outputStride,
+                             size_t width, size_t height) const {
+    return convert(input, inputFormat, inputStride, output, outputFormat, outputStride,
+                   width, height, PixelRect{0, 0, width, height});
+}
+
+bool ColorConverter::convert(const void* input, PixelFormat inputFormat, size_t inputStride,
+                             void* output, PixelFormat outputFormat, size_t outputStride,
+                             size_t width, size_t height, const PixelRect& region) const {
+    const size_t inPixel = bytesPerPixel(inputFormat);
+    const size_t outPixel = bytesPerPixel(outputFormat);
+    if (inputStride == 0) inputStride = width * inPixel;
+    if (outputStride == 0) outputStride = width * outPixel;
+
+    if (region.x + region.width > width || region.y + region.height > height ||
+        inputStride < width * inPixel || outputStride < width * outPixel) {
+        std::cerr << "Geçersiz bölge veya satır aralığı" << std::endl;
         return false;
     }
-    
-    cmsDoTransform(hTransform, rgbData, cmykData, pixelCount);
+    if (region.width == 0 || region.height == 0) return true;
+
+    // Bölge satırları bitişikse tek satırlık düz dönüşümle aynıdır
+    if (region.width == width && inputStride == width * inPixel && outputStride == width * outPixel) {
+        return convert(static_cast<const uint8_t*>(input) + region.y * inputStride, inputFormat,
+                       static_cast<uint8_t*>(output) + region.y * outputStride, outputFormat,
+                       width * region.height);
+    }
+
+    const Lut3D* table = nullptr;
+    cmsHTRANSFORM h = nullptr;
+    if (!prepare(inputFormat, outputFormat, false, table, h)) return false;
+
+    const size_t pixels = region.width * region.height;
+    Instrumentation::Scope scope(*instr, Stage::TransformExecute);
+    instr->addPixels(pixels, pixels * inPixel, pixels * outPixel);
+
+    const uint8_t* in = static_cast<const uint8_t*>(input) + region.y * inputStride + region.x * inPixel;
+    uint8_t* out = static_cast<uint8_t*>(output) + region.y * outputStride + region.x * outPixel;
+
+    // Satır aralığı: lcms stride'ları doğrudan kullanır, LUT satır satır çalışır
+    auto run = [&](size_t begin, size_t end) {
+        if (table) {
+            for (size_t row = begin; row < end; ++row) {
+                table->apply(in + row * inputStride, inputFormat,
+                             out + row * outputStride, outputFormat, region.width);
+            }
+        } else {
+            cmsDoTransformLineStride(h, in + begin * inputStride, out + begin * outputStride,
+                                     static_cast<cmsUInt32Number>(region.width),
+                                     static_cast<cmsUInt32Number>(end - begin),
+                                     static_cast<cmsUInt32Number>(inputStride),
+                                     static_cast<cmsUInt32Number>(outputStride),
+                                     0, 0);
+        }
+    };
+
+    const size_t chunkRows = std::max<size_t>(chunkPixels / region.width, 1);
+    if (!pool || region.height <= chunkRows) {
+        run(0, region.height);
+        return true;
+    }
+
+    pool->parallelFor(region.height, chunkRows, run);
+    return true;
+}
+
+bool ColorConverter::convertPlanar(const void* input, PixelFormat inputFormat,
+                                   const CMYKPlanes& output, PixelFormat outputFormat,
+                                   size_t pixelCount) const {
+    const Lut3D* table = nullptr;
+    cmsHTRANSFORM h = nullptr;
+    if (!prepare(inputFormat, outputFormat, true, table, h)) return false;
+
+    const size_t inStride = bytesPerPixel(inputFormat);
+    const size_t sample = bytesPerPixel(outputFormat) / 4;
+    Instrumentation::Scope scope(*instr, Stage::TransformExecute);
+    instr->addPixels(pixelCount, pixelCount * inStride, pixelCount * sample * 4);
+
+    const uint8_t* in = static_cast<const uint8_t*>(input);
+    uint8_t* const planes[4] = {static_cast<uint8_t*>(output.planes[0]), static_cast<uint8_t*>(output.planes[1]),
+                                static_cast<uint8_t*>(output.planes[2]), static_cast<uint8_t*>(output.planes[3])};
+
+    // lcms düzlem i'yi output + i * BytesPerPlaneOut konumunda bekler; düzlemler
+    // tek bir buffer'da eşit aralıklıysa doğrudan oraya yazılır
+    const ptrdiff_t spacing = planes[1] - planes[0];
+    const bool uniform = spacing > 0 && planes[2] - planes[1] == spacing && planes[3] - planes[2] == spacing &&
+                         static_cast<uint64_t>(spacing) <= UINT32_MAX;
+
+    auto run = [&](size_t begin, size_t end) {
+        if (table) {
+            const CMYKPlanes part = {{planes[0] + begin * sample, planes[1] + begin * sample,
+                                      planes[2] + begin * sample, planes[3] + begin * sample}};
+            table->applyPlanar(in + begin * inStride, inputFormat, part, outputFormat, end - begin);
+            return;
+        }
+        if (uniform) {
+            const cmsUInt32Number count = static_cast<cmsUInt32Number>(end - begin);
+            cmsDoTransformLineStride(h, in + begin * inStride, planes[0] + begin * sample,
+                                     count, 1,
+                                     static_cast<cmsUInt32Number>(count * inStride),
+                                     static_cast<cmsUInt32Number>(count * sample),
+                                     0, static_cast<cmsUInt32Number>(spacing));
+            return;
+        }
+        // Dağınık düzlemler: L1'de kalan küçük bir düzlemsel buffer üzerinden
+        alignas(64) uint8_t scratch[4 * kPlanarScratchPixels * sizeof(uint16_t)];
+        const size_t planeBytes = kPlanarScratchPixels * sample;
+        for (size_t at = begin; at < end; at += kPlanarScratchPixels) {
+            const size_t count = std::min(kPlanarScratchPixels, end - at);
+            cmsDoTransformLineStride(h, in + at * inStride, scratch,
+                                     static_cast<cmsUInt32Number>(count), 1,
+                                     static_cast<cmsUInt32Number>(count * inStride),
+                                     static_cast<cmsUInt32Number>(count * sample),
+                                     0, static_cast<cmsUInt32Number>(planeBytes));
+            for (size_t c = 0; c < 4; ++c) {
+                std::memcpy(planes[c] + at * sample, scratch + c * planeBytes, count * sample);
+            }
+        }
+    };
+
+    if (!pool || pixelCount <= chunkPixels) {
+        run(0, pixelCount);
+        return true;
+    }
+
+    pool->parallelFor(pixelCount, chunkPixels, run);
     return true;
+}
+
+TransformEngine ColorConverter::engine(PixelFormat inputFormat, PixelFormat outputFormat) const {
+    if (lut && Lut3D::supports(inputFormat, outputFormat)) return TransformEngine::Lut;
+    return TransformCache::engineOf(transformFor(inputFormat, outputFormat));
+}
+
+LutAccuracy ColorConverter::lutAccuracy(unsigned samplesPerAxis) const {
+    if (!lut) return LutAccuracy();
+    return lut->measureAccuracy(transformFor(PixelFormat::RGB16, PixelFormat::CMYK16),
+                                outProfile.get(), samplesPerAxis);
+}
+
+void ColorConverter::setThreadCount(unsigned count) {
+    if (count == 0) count = ThreadPool::hardwareThreads();
+    if (count == threadCount) return;
+
+    threadCount = count;
+    // Çağıran thread de çalıştığı için havuzda bir eksik worker yeterli
+    pool.reset();
+    if (threadCount > 1) pool.reset(new ThreadPool(threadCount - 1));
+}
+
+void ColorConverter::setChunkPixels(size_t pixels) {
+    chunkPixels = pixels ? pixels : kDefaultChunkPixels;
 } 
\ No newline at end of file
@@ -0,0 +1,223 @@
+#include "color/ConversionJob.hpp"
+#include <algorithm>
+#include <exception>
+
+namespace {
+    // Bellek işlerinde iptal kontrolü ve ilerleme adımı (piksel)
+    constexpr size_t kPixelsPerStep = 256 * 1024;
+
+    uint64_t pack(uint64_t done, uint64_t total) {
+        return (done << 32) | (total & 0xFFFFFFFFu);
+    }
+}
+
+const char* jobStateName(JobState state) {
+    switch (state) {
+        case JobState::Queued:    return "queued";
+        case JobState::Running:   return "running";
+        case JobState::Succeeded: return "succeeded";
+        case JobState::Failed:    return "failed";
+        case JobState::Cancelled: return "cancelled";
+    }
+    return "unknown";
+}
+
+ConversionJob::ConversionJob(uint64_t id, ProgressCallback onProgress)
+    : jobId(id), callback(std::move(onProgress)), currentState(JobState::Queued),
+      rows(0), strips(0), result(promise.get_future().share()) {}
+
+bool ConversionJob::finished() const {
+    const JobState s = state();
+    return s == JobState::Succeeded || s == JobState::Failed || s == JobState::Cancelled;
+}
+
+ConversionProgress ConversionJob::progress() const {
+    const uint64_t r = rows.load(std::memory_order_relaxed);
+    const uint64_t s = strips.load(std::memory_order_relaxed);
+    ConversionProgress p;
+    p.rowsDone = static_cast<uint32_t>(r >> 32);
+    p.totalRows = static_cast<uint32_t>(r);
+    p.stripsDone = static_cast<size_t>(s >> 32);
+    p.totalStrips = static_cast<size_t>(s & 0xFFFFFFFFu);
+    return p;
+}
+
+bool ConversionJob::waitFor(std::chrono::milliseconds timeout) const {
+    return result.wait_for(timeout) == std::future_status::ready;
+}
+
+void ConversionJob::report(const ConversionProgress& p) {
+    rows.store(pack(p.rowsDone, p.totalRows), std::memory_order_relaxed);
+    strips.store(pack(p.stripsDone, p.totalStrips), std::memory_order_relaxed);
+    if (callback) callback(p);
+}
+
+void ConversionJob::finish(JobResult finalResult) {
+    // Sonuç önce hazırlanır: bitmiş durumu gören wait() beklemez
+    const JobState finalState = finalResult.state;
+    promise.set_value(std::move(finalResult));
+    currentState.store(finalState, std::memory_order_release);
+}
+
+ConversionQueue::ConversionQueue(unsigned concurrentJobs)
+    : nextId(1), pool(std::max(concurrentJobs, 1u)) {}
+
+ConversionQueue::~ConversionQueue() {
+    // Bekleyen görevler iptal bayrağını görüp hemen biter; pool üyesi
+    // yıkılırken kuyruğu boşaltır ve worker'ları bekler
+    cancelAll();
+}
+
+std::shared_ptr<ConversionJob> ConversionQueue::track(ProgressCallback onProgress) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::shared_ptr<ConversionJob> job(new ConversionJob(nextId++, std::move(onProgress)));
+    // Bitmiş işlerin kayıtlarını temizle
+    jobs.erase(std::remove_if(jobs.begin(), jobs.end(),
+                              [](const std::weak_ptr<ConversionJob>& j) {
+                                  std::shared_ptr<ConversionJob> alive = j.lock();
+                                  return !alive || alive->finished();
+                              }),
+               jobs.end());
+    jobs.push_back(job);
+    return job;
+}
+
+std::unique_ptr<ImageColorConverter> ConversionQueue::acquire() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!idle.empty()) {
+            std::unique_ptr<ImageColorConverter> converter = std::move(idle.back());
+            idle.pop_back();
+            return converter;
+        }
+    }
+    std::unique_ptr<ImageColorConverter> converter(new ImageColorConverter());
+    converter->setVerbose(false);
+    return converter;
+}
+
+void ConversionQueue::recycle(std::unique_ptr<ImageColorConverter> converter) {
+    std::lock_guard<std::mutex> lock(mutex);
+    idle.push_back(std::move(converter));
+}
+
+std::shared_ptr<ConversionJob> ConversionQueue::submit(const ConversionRequest& request,
+                                                       ProgressCallback onProgress) {
+    std::shared_ptr<ConversionJob> job = track(std::move(onProgress));
+
+    pool.submit([this, job, request] {
+        JobResult result;
+        if (job->token.cancelled()) {
+            result.state = JobState::Cancelled;
+            job->finish(std::move(result));
+            return;
+        }
+        job->currentState.store(JobState::Running, std::memory_order_release);
+
+        std::unique_ptr<ImageColorConverter> converter = acquire();
+        try {
+            // Profiller ve transform TransformCache'ten; tekrar eden işlerde ucuz
+            if (!converter->initialize(request.rgbProfilePath, request.cmykProfilePath, request.options)) {
+                result.state = JobState::Failed;
+                result.error = "ICC profilleri yüklenemedi";
+            } else {
+                converter->colorConverter().setThreadCount(request.threads);
+                converter->setMemoryBudget(request.memoryBudget);
+                converter->setTiffOptions(request.tiff);
+                converter->setInkAnalysis(request.inkAnalysis, request.ink);
+                converter->setTileCache(request.tileCache);
+                const bool ok = converter->convertImage(
+                    request.inputPath, request.outputPath,
+                    [&](const ConversionProgress& p) { job->report(p); }, job->token);
+
+                result.stats = converter->lastPipelineStats();
+                result.ink = converter->lastInkStats();
+                if (ok) {
+                    result.state = JobState::Succeeded;
+                } else if (converter->lastCancelled()) {
+                    result.state = JobState::Cancelled;
+                } else {
+                    result.state = JobState::Failed;
+                    result.error = converter->lastError();
+                }
+            }
+        } catch (const std::exception& e) {
+            result.state = JobState::Failed;
+            result.error = e.what();
+        }
+        recycle(std::move(converter));
+        job->finish(std::move(result));
+    });
+    return job;
+}
+
+std::shared_ptr<ConversionJob> ConversionQueue::submit(const ColorConverter& converter,
+                                                       const void* input, PixelFormat inputFormat, size_t inputStride,
+                                                       void* output, PixelFormat outputFormat, size_t outputStride,
+                                                       size_t width, size_t height,
+                                                       ProgressCallback onProgress) {
+    std::shared_ptr<ConversionJob> job = track(std::move(onProgress));
+
+    pool.submit([job, &converter, input, inputFormat, inputStride, output, outputFormat, outputStride,
+                 width, height] {
+        JobResult result;
+        result.state = JobState::Cancelled;
+        if (job->token.cancelled()) {
+            job->finish(std::move(result));
+            return;
+        }
+        job->currentState.store(JobState::Running, std::memory_order_release);
+
+        const size_t inStride = inputStride ? inputStride : width * bytesPerPixel(inputFormat);
+        const size_t outStride = outputStride ? outputStride : width * bytesPerPixel(outputFormat);
+        const size_t step = std::max<size_t>(kPixelsPerStep / std::max<size_t>(width, 1), 1);
+
+        ConversionProgress progress;
+        progress.totalRows = static_cast<uint32_t>(height);
+        progress.totalStrips = (height + step - 1) / step;
+
+        bool ok = true;
+        size_t row = 0;
+        try {
+            for (; row < height && !job->token.cancelled(); row += step) {
+                const size_t rows = std::min(step, height - row);
+                ok = converter.convert(static_cast<const uint8_t*>(input) + row * inStride, inputFormat, inStride,
+                                       static_cast<uint8_t*>(output) + row * outStride, outputFormat, outStride,
+                                       width, rows);
+                if (!ok) break;
+                progress.rowsDone += static_cast<uint32_t>(rows);
+                ++progress.stripsDone;
+                job->report(progress);
+            }
+        } catch (const std::exception& e) {
+            ok = false;
+            result.error = e.what();
+        }
+
+        if (!ok) {
+            result.state = JobState::Failed;
+            if (result.error.empty()) result.error = "Renk dönüşümü başarısız";
+        } else if (row >= height) {
+            result.state = JobState::Succeeded;
+        }
+        job->finish(std::move(result));
+    });
+    return job;
+}
+
+void ConversionQueue::cancelAll() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const std::weak_ptr<ConversionJob>& entry : jobs) {
+        if (std::shared_ptr<ConversionJob> job = entry.lock()) job->cancel();
+    }
+}
+
+size_t ConversionQueue::activeJobs() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t count = 0;
+    for (const std::weak_ptr<ConversionJob>& entry : jobs) {
+        std::shared_ptr<ConversionJob> job = entry.lock();
+        if (job && !job->finished()) ++count;
+    }
+    return count;
+}
@@ -0,0 +1,453 @@
+#include "color/ImageColorConverter.hpp"
+#include "color/BoundedQueue.hpp"
+#include "color/ImageReader.hpp"
+#include "color/MappedFile.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+    // Varsayılan şerit bütçesi: 64 MB
+    constexpr size_t kDefaultMemoryBudget = 64u * 1024 * 1024;
+
+    // Piksel başına şerit belleği: CMYK16 çıktı (8 bayt) + çözülen RGB8 satırlar (3 bayt)
+    constexpr size_t kStripBytesPerPixel = sizeof(CMYK16) + sizeof(RGB8);
+
+    constexpr size_t kDefaultPipelineDepth = 4;
+
+    using Clock = std::chrono::steady_clock;
+
+    // Önceki ölçümden bu yana geçen saniye; ölçüm noktasını ilerletir
+    double lap(Clock::time_point& last) {
+        Clock::time_point now = Clock::now();
+        double seconds = std::chrono::duration<double>(now - last).count();
+        last = now;
+        return seconds;
+    }
+
+    struct Strip {
+        uint32_t index = 0;
+        int rows = 0;
+        RGB8* rgb = nullptr;        // aynı bloğun sonunda
+        CMYK16* cmyk = nullptr;     // arenadan
+        CMYKPlanes planes{};        // düzlemsel çıktıda aynı bloğun dört çeyreği
+        std::vector<TileKey> tileKeys;              // tile cache etkinse, yazıcının blok sırasıyla
+        std::vector<TileCache::Tile> cachedTiles;   // bulunanlar; diğerleri nullptr
+    };
+    using StripPtr = std::unique_ptr<Strip>;
+
+    // Aynı girdi tile'ından farklı çıktı üretebilecek her şeyin özeti
+    uint64_t tileContext(const ColorConverter& converter, const TiffWriteOptions& tiff, uint32_t tileSize,
+                         bool parallel) {
+        XxHash64 hash;
+        const uint32_t version = TileCache::kFormatVersion;
+        hash.update(&version, sizeof(version));
+        const ProfileId& input = converter.getInputCachedProfile().id;
+        const ProfileId& output = converter.getOutputCachedProfile().id;
+        hash.update(input.data(), input.size());
+        hash.update(output.data(), output.size());
+
+        const ConversionOptions& options = converter.getOptions();
+        const uint32_t values[] = {
+            static_cast<uint32_t>(options.intent), static_cast<uint32_t>(options.flags),
+            options.useFastFloat ? 1u : 0u, options.lutGridPoints,
+            static_cast<uint32_t>(tiff.compression), tiff.predictor ? 1u : 0u,
+            static_cast<uint32_t>(tiff.deflateLevel), static_cast<uint32_t>(tiff.zstdLevel),
+            tileSize, parallel ? 1u : 0u};
+        hash.update(values, sizeof(values));
+        return hash.digest();
+    }
+}
+
+ImageColorConverter::ImageColorConverter()
+    : memoryBudget(kDefaultMemoryBudget), pipelineDepth(kDefaultPipelineDepth),
+      imageBackend(ImageBackend::Auto), lastBackend(ImageBackend::Stb),
+      inkEnabled(false), cancelled(false), verbose(true) {
+    arena.setInstrumentation(&converter.instrumentation());
+}
+
+bool ImageColorConverter::initialize(const std::string& rgbProfilePath,
+                                     const std::string& cmykProfilePath) {
+    return converter.initialize(rgbProfilePath, cmykProfilePath);
+}
+
+bool ImageColorConverter::initialize(const std::string& rgbProfilePath,
+                                     const std::string& cmykProfilePath,
+                                     const ConversionOptions& options) {
+    return converter.initialize(rgbProfilePath, cmykProfilePath, options);
+}
+
+bool ImageColorConverter::initialize(const CachedProfile& rgbProfile,
+                                     const CachedProfile& cmykProfile,
+                                     const ConversionOptions& options) {
+    return converter.initialize(rgbProfile, cmykProfile, options);
+}
+
+bool ImageColorConverter::initialize(const ColorConverter& source) {
+    return converter.initialize(source);
+}
+
+void ImageColorConverter::setMemoryBudget(size_t bytes) {
+    memoryBudget = bytes ? bytes : kDefaultMemoryBudget;
+}
+
+void ImageColorConverter::setPipelineDepth(size_t strips) {
+    pipelineDepth = strips ? strips : kDefaultPipelineDepth;
+}
+
+int ImageColorConverter::rowsPerStrip(int width) const {
+    // Bütçe dolaşımdaki tüm şerit buffer'larına paylaştırılır
+    size_t rowBytes = static_cast<size_t>(std::max(width, 1)) * kStripBytesPerPixel * pipelineDepth;
+    size_t rows = std::max<size_t>(memoryBudget / rowBytes, 1);
+    return static_cast<int>(std::min<size_t>(rows, 1u << 16));
+}
+
+bool ImageColorConverter::convertImage(const std::string& inputPath,
+                                       const std::string& outputPath) {
+    return run(inputPath, outputPath, nullptr, nullptr);
+}
+
+bool ImageColorConverter::convertImage(const std::string& inputPath,
+                                       const std::string& outputPath,
+                                       const ProgressCallback& onProgress,
+                                       const CancelToken& cancel) {
+    return run(inputPath, outputPath, onProgress ? &onProgress : nullptr, &cancel);
+}
+
+bool ImageColorConverter::run(const std::string& inputPath, const std::string& outputPath,
+                              const ProgressCallback* onProgress, const CancelToken* cancel) {
+    if (verbose) {
+        std::cout << "Input path: " << inputPath << std::endl;
+        std::cout << "Output path: " << outputPath << std::endl;
+    }
+
+    stats = PipelineStats();
+    ink = InkStats();
+    errorMessage.clear();
+    cancelled = false;
+    Clock::time_point started = Clock::now();
+
+    // Aşama thread'lerinden gelen ilk hata saklanır
+    std::mutex errorMutex;
+    auto fail = [&](const std::string& message) {
+        std::cerr << message << std::endl;
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (errorMessage.empty()) errorMessage = message;
+    };
+
+    // Girdi bellek eşlemesiyle okunur: stdio kopyası yok, sayfalar çözülürken
+    // gelir. Eşlenemeyen girdiler (boş dosya, özel dosya) belleğe okunur.
+    MappedFile input;
+    std::vector<uint8_t> inputBytes;
+    const uint8_t* inputBegin = nullptr;
+    size_t inputSize = 0;
+    if (input.open(inputPath)) {
+        inputBegin = input.data();
+        inputSize = input.size();
+    } else {
+        std::ifstream file(inputPath, std::ios::binary);
+        if (!file) {
+            fail("Resim dosyası açılamadı: " + inputPath);
+            return false;
+        }
+        inputBytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        inputBegin = inputBytes.data();
+        inputSize = inputBytes.size();
+    }
+
+    // TIFF başlığı için boyutlar yalnızca dosya başlığından okunur
+    std::string readerError;
+    std::unique_ptr<ImageReader> reader = ImageReader::create(inputBegin, inputSize, imageBackend, &readerError);
+    if (!reader || reader->info().width > static_cast<uint32_t>(INT_MAX) ||
+        reader->info().height > static_cast<uint32_t>(INT_MAX)) {
+        fail("Resim yüklenemedi: " + inputPath + " (" + readerError + ")");
+        return false;
+    }
+    lastBackend = reader->backend();
+    const int width = static_cast<int>(reader->info().width);
+    const int height = static_cast<int>(reader->info().height);
+
+    Instrumentation& instr = converter.instrumentation();
+
+    // TIFF'e gömülecek ICC profili: profil açılırken okunan baytlar, paylaşılan
+    const ProfileData& profileData = converter.getOutputProfileData();
+    if (!profileData) {
+        fail("Converter başlatılmamış!");
+        return false;
+    }
+
+    if (!writer.open(outputPath, static_cast<uint32_t>(width), static_cast<uint32_t>(height),
+                     *profileData, tiffOptions)) {
+        fail("TIFF dosyası oluşturulamadı: " + outputPath);
+        return false;
+    }
+
+    // Pipeline şeritleri TIFF strip/tile bloklarının katı olmalı
+    const int blockRows = static_cast<int>(writer.blockRows());
+    const int stripRows = std::min(std::max(rowsPerStrip(width) / blockRows, 1) * blockRows, height);
+
+    // Tile cache yalnızca tile'ları bağımsız, doğrudan yazılabilen çıktıda
+    TileCache* cache = tileCache.get();
+    if (cache && (tiffOptions.layout != TiffLayout::Tiles || tiffOptions.planar || tiffOptions.pyramid ||
+                  inkEnabled)) {
+        if (verbose) {
+            std::cerr << "Tile cache yalnızca düz, bitişik tile'lı çıktıda ve mürekkep analizi "
+                         "kapalıyken kullanılır; atlanıyor" << std::endl;
+        }
+        cache = nullptr;
+    }
+    // Tile'lı düzende blok yüksekliği yazıcının (16'ya yuvarlanmış) tile boyutudur
+    const uint32_t tileSize = writer.blockRows();
+    const uint32_t tilesAcross = (static_cast<uint32_t>(width) + tileSize - 1) / tileSize;
+    const uint64_t context = cache ? tileContext(converter, tiffOptions, tileSize, writer.isParallel()) : 0;
+
+    // Şerit buffer'ları arenadan bir kez alınır ve aşamalar arasında dolaşır;
+    // kararlı durumda önceki çağrının blokları geri gelir
+    const size_t stripPixels = static_cast<size_t>(width) * stripRows;
+    BoundedQueue<StripPtr> freeStrips(pipelineDepth);
+    BoundedQueue<StripPtr> decoded(pipelineDepth);
+    BoundedQueue<StripPtr> converted(pipelineDepth);
+    std::vector<void*> stripBlocks;
+    for (size_t i = 0; i < pipelineDepth; ++i) {
+        StripPtr strip(new Strip());
+        void* block = arena.allocate(stripPixels * kStripBytesPerPixel);
+        if (!block) {
+            for (void* allocated : stripBlocks) ScratchArena::release(allocated);
+            writer.close();
+            std::remove(outputPath.c_str());
+            fail("Şerit belleği ayrılamadı");
+            return false;
+        }
+        stripBlocks.push_back(block);
+        strip->cmyk = static_cast<CMYK16*>(block);
+        strip->rgb = reinterpret_cast<RGB8*>(strip->cmyk + stripPixels);
+        for (size_t c = 0; c < 4; ++c) {
+            strip->planes.planes[c] = reinterpret_cast<uint16_t*>(block) + c * stripPixels;
+        }
+        freeStrips.push(std::move(strip));
+    }
+
+    std::atomic<bool> failed(false);
+    auto abort = [&] {
+        failed = true;
+        freeStrips.close();
+        decoded.close();
+        converted.close();
+    };
+
+    // İptal hata sayılmaz, mesaj yazdırılmaz; pipeline hata gibi boşaltılır
+    std::atomic<bool> stopped(false);
+    auto cancelRequested = [&] {
+        if (!cancel || !cancel->cancelled()) return false;
+        if (!stopped.exchange(true)) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (errorMessage.empty()) errorMessage = "Dönüşüm iptal edildi";
+        }
+        abort();
+        return true;
+    };
+
+    ConversionProgress progress;
+    progress.totalRows = static_cast<uint32_t>(height);
+    progress.totalStrips = static_cast<size_t>((height + stripRows - 1) / stripRows);
+
+    // Decode aşaması: her şeridin satırları okuyucudan doğrudan şeridin RGB
+    // buffer'ına çözülür. Satır satır çözen arka uçlarda ilk şerit dosyanın
+    // geri kalanı çözülmeden dönüşüme gider; stb ilk okumada tamamını çözer.
+    std::thread decodeThread([&] {
+        Clock::time_point t = Clock::now();
+        // stb'nin ayırmaları (çözülmüş görüntü dahil) arenadan gelir
+        ScratchArena::Binding binding(arena);
+
+        uint32_t index = 0;
+        for (int row = 0; row < height && !failed; row += stripRows, ++index) {
+            StripPtr strip;
+            if (!freeStrips.pop(strip) || cancelRequested()) break;
+            stats.decode.idleSeconds += lap(t);
+
+            strip->index = index;
+            strip->rows = std::min(stripRows, height - row);
+            bool decodedOk;
+            {
+                Instrumentation::Scope scope(instr, Stage::ImageDecode);
+                decodedOk = reader->readRows(strip->rgb, 0, static_cast<uint32_t>(strip->rows));
+            }
+            stats.decode.busySeconds += lap(t);
+            if (!decodedOk) {
+                fail("Resim yüklenemedi: " + inputPath + " (" + reader->error() + ")");
+                abort();
+                return;
+            }
+
+            if (!decoded.push(std::move(strip))) break;
+            stats.decode.idleSeconds += lap(t);
+        }
+        decoded.close();
+    });
+
+    // Encode aşaması: şeritler sırayla gelir, TIFF'e yazılıp havuza döner
+    std::thread encodeThread([&] {
+        Clock::time_point t = Clock::now();
+        StripPtr strip;
+        while (converted.pop(strip)) {
+            stats.encode.idleSeconds += lap(t);
+
+            const size_t bytes = static_cast<size_t>(width) * strip->rows * sizeof(CMYK16);
+            bool written;
+            {
+                Instrumentation::Scope scope(instr, Stage::TiffWrite);
+                const uint32_t first = strip->index * static_cast<uint32_t>(stripRows);
+                if (tiffOptions.planar) {
+                    written = writer.writePlanes(first, static_cast<uint32_t>(strip->rows), strip->planes);
+                } else if (cache) {
+                    std::vector<const std::vector<uint8_t>*> encoded(strip->cachedTiles.size());
+                    for (size_t j = 0; j < encoded.size(); ++j) encoded[j] = strip->cachedTiles[j].get();
+                    written = writer.writeRows(first, static_cast<uint32_t>(strip->rows), strip->cmyk,
+                                               encoded.data());
+                    // Yeni tile'lar yazıldıkları haliyle cache'e
+                    for (size_t j = 0; written && j < encoded.size(); ++j) {
+                        if (encoded[j]) {
+                            ++stats.cachedTiles;
+                            strip->cachedTiles[j].reset();
+                        } else {
+                            cache->store(strip->tileKeys[j], writer.blockData(j));
+                        }
+                    }
+                    stats.tiles += encoded.size();
+                } else {
+                    written = writer.writeRows(first, static_cast<uint32_t>(strip->rows), strip->cmyk);
+                }
+            }
+            if (!written) {
+                fail("TIFF yazma hatası: " + outputPath);
+                abort();
+                return;
+            }
+            instr.addTiffBytes(static_cast<uint64_t>(bytes));
+            ++stats.strips;
+            stats.encode.busySeconds += lap(t);
+
+            // Şeritler sırayla yazıldığından ilerleme tekdüze artar
+            progress.rowsDone += static_cast<uint32_t>(strip->rows);
+            ++progress.stripsDone;
+            if (onProgress) (*onProgress)(progress);
+
+            freeStrips.push(std::move(strip));
+            stats.encode.idleSeconds += lap(t);
+        }
+    });
+
+    // Transform aşaması çağıran thread'de çalışır; converter'ın thread
+    // havuzu ayarlıysa her şerit ayrıca paralel dönüştürülür.
+    {
+        Clock::time_point t = Clock::now();
+        StripPtr strip;
+        while (decoded.pop(strip)) {
+            if (cancelRequested()) break;
+            stats.transform.idleSeconds += lap(t);
+
+            // 8-bit RGB doğrudan 16-bit CMYK'ya, genişletme kopyası olmadan
+            const size_t pixels = static_cast<size_t>(width) * strip->rows;
+            bool convertedOk;
+            if (tiffOptions.planar) {
+                convertedOk = converter.convertPlanar(strip->rgb, PixelFormat::RGB8, strip->planes,
+                                                      PixelFormat::CMYK16, pixels);
+            } else if (inkEnabled) {
+                // Mürekkep istatistiği şerit dönüştürülürken toplanır
+                InkStats part;
+                convertedOk = converter.convert(strip->rgb, strip->cmyk, pixels, inkOptions, part);
+                part.maxTacPixel += static_cast<size_t>(strip->index) * stripRows * width;
+                ink.merge(part);
+            } else if (cache) {
+                // Tile'lar şeridin RGB satırlarından özetlenir; yalnızca
+                // cache'te olmayanlar dönüştürülür
+                const size_t rgbStride = static_cast<size_t>(width) * sizeof(RGB8);
+                const uint32_t bands = (static_cast<uint32_t>(strip->rows) + tileSize - 1) / tileSize;
+                const size_t count = static_cast<size_t>(bands) * tilesAcross;
+                strip->tileKeys.resize(count);
+                strip->cachedTiles.assign(count, nullptr);
+                size_t hits = 0;
+                for (size_t j = 0; j < count; ++j) {
+                    const uint32_t x = static_cast<uint32_t>(j % tilesAcross) * tileSize;
+                    const uint32_t y = static_cast<uint32_t>(j / tilesAcross) * tileSize;
+                    const uint32_t dims[2] = {std::min(tileSize, static_cast<uint32_t>(width) - x),
+                                              std::min(tileSize, static_cast<uint32_t>(strip->rows) - y)};
+                    XxHash64 hash;
+                    hash.update(dims, sizeof(dims));
+                    const uint8_t* row = reinterpret_cast<const uint8_t*>(strip->rgb) + y * rgbStride +
+                                         static_cast<size_t>(x) * sizeof(RGB8);
+                    for (uint32_t r = 0; r < dims[1]; ++r, row += rgbStride) {
+                        hash.update(row, static_cast<size_t>(dims[0]) * sizeof(RGB8));
+                    }
+                    strip->tileKeys[j] = TileKey{hash.digest(), context};
+                    strip->cachedTiles[j] = cache->find(strip->tileKeys[j]);
+                    if (strip->cachedTiles[j]) ++hits;
+                }
+
+                if (hits == 0) {
+                    convertedOk = converter.convert(strip->rgb, strip->cmyk, pixels);
+                } else {
+                    convertedOk = true;
+                    for (size_t j = 0; convertedOk && j < count; ++j) {
+                        if (strip->cachedTiles[j]) continue;
+                        PixelRect tile;
+                        tile.x = (j % tilesAcross) * tileSize;
+                        tile.y = (j / tilesAcross) * tileSize;
+                        tile.width = std::min<size_t>(tileSize, static_cast<size_t>(width) - tile.x);
+                        tile.height = std::min<size_t>(tileSize, static_cast<size_t>(strip->rows) - tile.y);
+                        convertedOk = converter.convert(strip->rgb, rgbStride, strip->cmyk,
+                                                        static_cast<size_t>(width) * sizeof(CMYK16),
+                                                        static_cast<size_t>(width), static_cast<size_t>(strip->rows),
+                                                        tile);
+                    }
+                }
+            } else {
+                convertedOk = converter.convert(strip->rgb, strip->cmyk, pixels);
+            }
+            if (!convertedOk) {
+                fail("Renk dönüşümü başarısız: " + inputPath);
+                abort();
+                break;
+            }
+            stats.transform.busySeconds += lap(t);
+
+            if (!converted.push(std::move(strip))) break;
+            stats.transform.idleSeconds += lap(t);
+        }
+        converted.close();
+    }
+
+    decodeThread.join();
+    encodeThread.join();
+
+    // Piramit seviyeleri ve son flush kapanışta; encode süresine sayılır
+    if (failed) {
+        writer.discard();
+    } else {
+        Clock::time_point t = Clock::now();
+        if (!writer.close()) {
+            fail("TIFF dosyası tamamlanamadı");
+            failed = true;
+        }
+        stats.encode.busySeconds += lap(t);
+    }
+    // stb'nin çözülmüş görüntüsü arenaya döner
+    reader.reset();
+    for (void* block : stripBlocks) ScratchArena::release(block);
+    input.close();
+    // Yarım kalmış çıktı geçerli bir dosya gibi görünmesin
+    if (failed) std::remove(outputPath.c_str());
+    cancelled = stopped;
+
+    stats.wallSeconds = lap(started);
+    return !failed;
+}
@@ -0,0 +1,345 @@
+#include "color/ImageReader.hpp"
+#include "stb_image.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+#ifdef COLOR_HAVE_PNG
+#include <png.h>
+#endif
+
+#ifdef COLOR_HAVE_JPEG
+#include <csetjmp>
+#include <cstdio>
+#include <jpeglib.h>
+#endif
+
+namespace {
+    bool isPng(const uint8_t* data, size_t size) {
+        static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        return size >= 8 && std::memcmp(data, signature, 8) == 0;
+    }
+
+    bool isJpeg(const uint8_t* data, size_t size) {
+        return size >= 3 && data[0] == 0xFF && data[1] == 0xD8 && data[2] == 0xFF;
+    }
+
+    // Satır satır okuma geçişli (interlaced) PNG'de mümkün değil; IHDR'deki
+    // interlace baytı imza (8) + uzunluk (4) + tür (4) + 12 bayt sonradır
+    bool isInterlacedPng(const uint8_t* data, size_t size) {
+        return size > 28 && data[28] != 0;
+    }
+
+    // Görüntünün tamamını ilk okumada çözer (stb satır satır çözemez).
+    // Ayırmalar çağıran thread'e bağlı ScratchArena'dan gelir.
+    class StbReader : public ImageReader {
+    public:
+        ~StbReader() override {
+            if (pixels) stbi_image_free(pixels);
+        }
+
+        bool open(const uint8_t* fileData, size_t fileSize) override {
+            if (fileSize > static_cast<size_t>(INT_MAX)) {
+                errorMessage = "dosya stb için çok büyük";
+                return false;
+            }
+            int w, h, c;
+            if (!stbi_info_from_memory(fileData, static_cast<int>(fileSize), &w, &h, &c)) {
+                errorMessage = stbi_failure_reason();
+                return false;
+            }
+            data = fileData;
+            size = fileSize;
+            imageInfo.width = static_cast<uint32_t>(w);
+            imageInfo.height = static_cast<uint32_t>(h);
+            imageInfo.channels = static_cast<unsigned>(c);
+            return true;
+        }
+
+        bool readRows(RGB8* out, size_t stride, uint32_t rows) override {
+            if (!pixels) {
+                int w, h, c;
+                pixels = stbi_load_from_memory(data, static_cast<int>(size), &w, &h, &c, 3);
+                if (!pixels) {
+                    errorMessage = stbi_failure_reason();
+                    return false;
+                }
+                if (static_cast<uint32_t>(w) != imageInfo.width || static_cast<uint32_t>(h) != imageInfo.height) {
+                    errorMessage = "başlık ve çözülen boyut uyuşmuyor";
+                    return false;
+                }
+            }
+            if (rows > imageInfo.height - nextRow) {
+                errorMessage = "görüntünün sonu aşıldı";
+                return false;
+            }
+
+            const size_t rowBytes = static_cast<size_t>(imageInfo.width) * sizeof(RGB8);
+            if (stride == 0) stride = rowBytes;
+            const uint8_t* from = pixels + static_cast<size_t>(nextRow) * rowBytes;
+            uint8_t* to = reinterpret_cast<uint8_t*>(out);
+            if (stride == rowBytes) {
+                std::memcpy(to, from, rowBytes * rows);
+            } else {
+                for (uint32_t row = 0; row < rows; ++row) {
+                    std::memcpy(to + row * stride, from + row * rowBytes, rowBytes);
+                }
+            }
+            nextRow += rows;
+            return true;
+        }
+
+        ImageBackend backend() const override { return ImageBackend::Stb; }
+
+    private:
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+        uint8_t* pixels = nullptr;
+    };
+
+#ifdef COLOR_HAVE_PNG
+    // libpng ile satır satır; palet, gri, 16-bit ve alfa stb ile aynı şekilde
+    // RGB8'e indirgenir (alfa atılır, 16-bit üst bayta kesilir)
+    class PngReader : public ImageReader {
+    public:
+        ~PngReader() override {
+            if (png) png_destroy_read_struct(&png, &pngInfo, nullptr);
+        }
+
+        bool open(const uint8_t* fileData, size_t fileSize) override {
+            data = fileData;
+            size = fileSize;
+            png = png_create_read_struct(PNG_LIBPNG_VER_STRING, this, onError, onWarning);
+            if (!png) return fail("libpng başlatılamadı");
+            pngInfo = png_create_info_struct(png);
+            if (!pngInfo) return fail("libpng başlatılamadı");
+
+            if (setjmp(png_jmpbuf(png))) return false;
+            png_set_read_fn(png, this, onRead);
+            png_read_info(png, pngInfo);
+
+            const png_byte colorType = png_get_color_type(png, pngInfo);
+            imageInfo.width = png_get_image_width(png, pngInfo);
+            imageInfo.height = png_get_image_height(png, pngInfo);
+            imageInfo.channels = png_get_channels(png, pngInfo);
+
+            png_set_expand(png);
+            png_set_strip_16(png);
+            png_set_strip_alpha(png);
+            if (colorType == PNG_COLOR_TYPE_GRAY || colorType == PNG_COLOR_TYPE_GRAY_ALPHA) {
+                png_set_gray_to_rgb(png);
+            }
+            png_read_update_info(png, pngInfo);
+            if (png_get_rowbytes(png, pngInfo) != static_cast<size_t>(imageInfo.width) * sizeof(RGB8)) {
+                return fail("desteklenmeyen PNG biçimi");
+            }
+            return true;
+        }
+
+        bool readRows(RGB8* out, size_t stride, uint32_t rows) override {
+            if (rows > imageInfo.height - nextRow) return fail("görüntünün sonu aşıldı");
+            if (!decodeRows(reinterpret_cast<uint8_t*>(out),
+                            stride ? stride : static_cast<size_t>(imageInfo.width) * sizeof(RGB8), rows)) {
+                return false;
+            }
+            nextRow += rows;
+            return true;
+        }
+
+        ImageBackend backend() const override { return ImageBackend::LibPng; }
+
+    private:
+        // setjmp ayrı çerçevede: longjmp'ta bozulabilecek, setjmp'tan sonra
+        // değişen yerel değişken yoktur (-Wclobbered)
+        bool decodeRows(uint8_t* const to, const size_t rowStride, const uint32_t rows) {
+            if (setjmp(png_jmpbuf(png))) return false;
+            for (uint32_t row = 0; row < rows; ++row) {
+                png_read_row(png, to + row * rowStride, nullptr);
+            }
+            return true;
+        }
+
+        bool fail(const char* message) {
+            errorMessage = message;
+            return false;
+        }
+
+        static void onRead(png_structp png, png_bytep out, png_size_t length) {
+            PngReader* self = static_cast<PngReader*>(png_get_io_ptr(png));
+            if (length > self->size - self->offset) png_error(png, "dosya beklenenden kısa");
+            std::memcpy(out, self->data + self->offset, length);
+            self->offset += length;
+        }
+
+        static void onError(png_structp png, png_const_charp message) {
+            PngReader* self = static_cast<PngReader*>(png_get_error_ptr(png));
+            self->errorMessage = message;
+            png_longjmp(png, 1);
+        }
+
+        static void onWarning(png_structp, png_const_charp) {}
+
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+        size_t offset = 0;
+        png_structp png = nullptr;
+        png_infop pngInfo = nullptr;
+    };
+#endif
+
+#ifdef COLOR_HAVE_JPEG
+    // libjpeg(-turbo) ile satır satır (jpeg_read_scanlines). CMYK/YCCK
+    // JPEG'ler RGB'ye çevrilemediği için reddedilir.
+    class JpegReader : public ImageReader {
+    public:
+        JpegReader() {
+            decoder.err = jpeg_std_error(&errors.base);
+            errors.base.error_exit = onError;
+            errors.base.output_message = [](j_common_ptr) {};
+            errors.owner = this;
+        }
+
+        ~JpegReader() override {
+            if (created) jpeg_destroy_decompress(&decoder);
+        }
+
+        bool open(const uint8_t* fileData, size_t fileSize) override {
+            if (setjmp(errors.jump)) return false;
+            jpeg_create_decompress(&decoder);
+            created = true;
+            jpeg_mem_src(&decoder, const_cast<unsigned char*>(fileData), static_cast<unsigned long>(fileSize));
+            jpeg_read_header(&decoder, TRUE);
+
+            if (decoder.jpeg_color_space == JCS_CMYK || decoder.jpeg_color_space == JCS_YCCK) {
+                errorMessage = "CMYK JPEG desteklenmiyor";
+                return false;
+            }
+            decoder.out_color_space = JCS_RGB;
+            jpeg_start_decompress(&decoder);
+
+            imageInfo.width = decoder.output_width;
+            imageInfo.height = decoder.output_height;
+            imageInfo.channels = static_cast<unsigned>(decoder.num_components);
+            if (decoder.output_components != 3) {
+                errorMessage = "desteklenmeyen JPEG biçimi";
+                return false;
+            }
+            return true;
+        }
+
+        bool readRows(RGB8* out, size_t stride, uint32_t rows) override {
+            if (rows > imageInfo.height - nextRow) {
+                errorMessage = "görüntünün sonu aşıldı";
+                return false;
+            }
+            if (!decodeRows(reinterpret_cast<uint8_t*>(out),
+                            stride ? stride : static_cast<size_t>(imageInfo.width) * sizeof(RGB8), rows)) {
+                return false;
+            }
+            nextRow += rows;
+            return true;
+        }
+
+        ImageBackend backend() const override { return ImageBackend::LibJpeg; }
+
+    private:
+        // setjmp ayrı çerçevede; longjmp sonrası yalnızca false döner, döngüde
+        // değişen sayaçlar bir daha okunmaz (-Wclobbered). Son satırlarla
+        // birlikte jpeg_finish_decompress de aynı setjmp altında çağrılır;
+        // dosya sonundaki bozuk veri de onError'dan buraya döner.
+        bool decodeRows(uint8_t* const to, const size_t rowStride, const uint32_t rows) {
+            if (setjmp(errors.jump)) return false;
+            uint32_t done = 0;
+            while (done < rows) {
+                // libjpeg-turbo birden çok satırı tek çağrıda verebilir
+                JSAMPROW lines[16];
+                const uint32_t batch = std::min<uint32_t>(rows - done, 16);
+                for (uint32_t i = 0; i < batch; ++i) lines[i] = to + (done + i) * rowStride;
+                const JDIMENSION read = jpeg_read_scanlines(&decoder, lines, batch);
+                if (read == 0) {
+                    errorMessage = "JPEG verisi eksik";
+                    return false;
+                }
+                done += read;
+            }
+            if (nextRow + rows == imageInfo.height) jpeg_finish_decompress(&decoder);
+            return true;
+        }
+
+        struct ErrorManager {
+            jpeg_error_mgr base;
+            std::jmp_buf jump;
+            JpegReader* owner;
+        };
+
+        static void onError(j_common_ptr info) {
+            ErrorManager* manager = reinterpret_cast<ErrorManager*>(info->err);
+            char message[JMSG_LENGTH_MAX];
+            info->err->format_message(info, message);
+            manager->owner->errorMessage = message;
+            std::longjmp(manager->jump, 1);
+        }
+
+        jpeg_decompress_struct decoder;
+        ErrorManager errors;
+        bool created = false;
+    };
+#endif
+
+    std::unique_ptr<ImageReader> makeReader(ImageBackend backend) {
+        switch (backend) {
+#ifdef COLOR_HAVE_PNG
+            case ImageBackend::LibPng: return std::unique_ptr<ImageReader>(new PngReader());
+#endif
+#ifdef COLOR_HAVE_JPEG
+            case ImageBackend::LibJpeg: return std::unique_ptr<ImageReader>(new JpegReader());
+#endif
+            default: return std::unique_ptr<ImageReader>(new StbReader());
+        }
+    }
+}
+
+const char* backendName(ImageBackend backend) {
+    switch (backend) {
+        case ImageBackend::Stb:     return "stb_image";
+        case ImageBackend::LibPng:  return "libpng";
+        case ImageBackend::LibJpeg: return "libjpeg";
+        default:                    return "auto";
+    }
+}
+
+bool ImageReader::available(ImageBackend backend) {
+    switch (backend) {
+#ifdef COLOR_HAVE_PNG
+        case ImageBackend::LibPng: return true;
+#endif
+#ifdef COLOR_HAVE_JPEG
+        case ImageBackend::LibJpeg: return true;
+#endif
+        case ImageBackend::Auto:
+        case ImageBackend::Stb: return true;
+        default: return false;
+    }
+}
+
+std::unique_ptr<ImageReader> ImageReader::create(const uint8_t* data, size_t size,
+                                                 ImageBackend preferred, std::string* errorOut) {
+    // Dosya türüne uyan arka uç; uymuyorsa veya derlenmemişse stb
+    ImageBackend chosen = ImageBackend::Stb;
+    const bool png = isPng(data, size) && !isInterlacedPng(data, size);
+    const bool jpeg = isJpeg(data, size);
+    if ((preferred == ImageBackend::Auto || preferred == ImageBackend::LibPng) && png &&
+        available(ImageBackend::LibPng)) {
+        chosen = ImageBackend::LibPng;
+    } else if ((preferred == ImageBackend::Auto || preferred == ImageBackend::LibJpeg) && jpeg &&
+               available(ImageBackend::LibJpeg)) {
+        chosen = ImageBackend::LibJpeg;
+    }
+
+    std::unique_ptr<ImageReader> reader = makeReader(chosen);
+    if (!reader->open(data, size)) {
+        if (errorOut) *errorOut = reader->error();
+        return nullptr;
+    }
+    return reader;
+}
@@ -0,0 +1,226 @@
+#include "color/InkStatistics.hpp"
+#include <algorithm>
+#include <climits>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#include <immintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define INK_AVX2 1
+#endif
+#endif
+
+namespace {
+    // TAC'ın en yükseği bu büyüklükte bloklar halinde aranır; yeni bir en
+    // yüksek değer görülen blok skaler olarak yeniden taranır
+    constexpr size_t kBlockPixels = 64;
+
+    struct Reduction {
+        uint64_t sum[4] = {0, 0, 0, 0};
+        uint32_t max[4] = {0, 0, 0, 0};
+        uint32_t maxTac = 0;
+        size_t maxTacAt = 0;
+        uint64_t over = 0;
+    };
+
+    template <typename T>
+    void reduceScalar(const T* px, size_t count, size_t offset, uint32_t limit, Reduction& r) {
+        for (size_t i = 0; i < count; ++i) {
+            const T* p = px + i * 4;
+            uint32_t tac = 0;
+            for (size_t c = 0; c < 4; ++c) {
+                r.sum[c] += p[c];
+                r.max[c] = std::max<uint32_t>(r.max[c], p[c]);
+                tac += p[c];
+            }
+            if (tac > r.maxTac) {
+                r.maxTac = tac;
+                r.maxTacAt = offset + i;
+            }
+            r.over += tac > limit;
+        }
+    }
+
+#if defined(INK_AVX2)
+    // 16-bit CMYK: 4 piksel = bir 256-bit kayıt. Kanal toplamları 32-bit
+    // şeritlerde biriktirilip her blokta 64-bit'e aktarılır; piksel başına
+    // TAC iki hadd ile kayıt içinde hesaplanır.
+    __attribute__((target("avx2")))
+    void reduce16Avx2(const uint16_t* px, size_t count, uint32_t limit, Reduction& r) {
+        const __m256i vlimit = _mm256_set1_epi32(static_cast<int>(std::min<uint32_t>(limit, INT_MAX)));
+        __m256i vmax = _mm256_setzero_si256();
+        __m256i sum64 = _mm256_setzero_si256();
+        __m256i overAcc = _mm256_setzero_si256();
+
+        size_t i = 0;
+        for (; i + kBlockPixels <= count; i += kBlockPixels) {
+            __m256i sum32 = _mm256_setzero_si256();
+            __m256i tacMax = _mm256_setzero_si256();
+            for (size_t s = 0; s < kBlockPixels; s += 4) {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(px + (i + s) * 4));
+                vmax = _mm256_max_epu16(vmax, v);
+                const __m256i lo = _mm256_cvtepu16_epi32(_mm256_castsi256_si128(v));     // piksel 0, 1
+                const __m256i hi = _mm256_cvtepu16_epi32(_mm256_extracti128_si256(v, 1)); // piksel 2, 3
+                sum32 = _mm256_add_epi32(sum32, _mm256_add_epi32(lo, hi));
+                // [tac0, tac2, tac0, tac2 | tac1, tac3, tac1, tac3]
+                const __m256i pairs = _mm256_hadd_epi32(lo, hi);
+                const __m256i tac = _mm256_hadd_epi32(pairs, pairs);
+                tacMax = _mm256_max_epu32(tacMax, tac);
+                overAcc = _mm256_sub_epi32(overAcc, _mm256_cmpgt_epi32(tac, vlimit));
+            }
+            sum64 = _mm256_add_epi64(sum64, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(sum32)));
+            sum64 = _mm256_add_epi64(sum64, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(sum32, 1)));
+
+            alignas(32) uint32_t tacs[8];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(tacs), tacMax);
+            const uint32_t blockMax = *std::max_element(tacs, tacs + 8);
+            if (blockMax > r.maxTac) {
+                for (size_t j = 0; j < kBlockPixels; ++j) {
+                    const uint16_t* p = px + (i + j) * 4;
+                    if (uint32_t(p[0]) + p[1] + p[2] + p[3] == blockMax) {
+                        r.maxTac = blockMax;
+                        r.maxTacAt = i + j;
+                        break;
+                    }
+                }
+            }
+        }
+
+        alignas(32) uint64_t sums[4];
+        alignas(32) uint16_t maxima[16];
+        alignas(32) uint32_t overs[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(sums), sum64);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(maxima), vmax);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(overs), overAcc);
+        uint64_t over = 0;
+        for (size_t c = 0; c < 8; ++c) over += overs[c];
+        for (size_t c = 0; c < 4; ++c) {
+            r.sum[c] += sums[c];
+            r.max[c] = std::max<uint32_t>(r.max[c], std::max({maxima[c], maxima[c + 4], maxima[c + 8], maxima[c + 12]}));
+        }
+        r.over += over / 2;     // her TAC kayıtta iki kez bulunur
+
+        reduceScalar(px + i * 4, count - i, i, limit, r);
+    }
+
+    bool haveAvx2() {
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported;
+    }
+#endif
+
+    template <typename T>
+    void reduce(const T* px, size_t count, uint32_t limit, Reduction& r) {
+#if defined(INK_AVX2)
+        if (sizeof(T) == 2 && haveAvx2()) {
+            reduce16Avx2(reinterpret_cast<const uint16_t*>(px), count, limit, r);
+            return;
+        }
+#endif
+        reduceScalar(px, count, 0, limit, r);
+    }
+
+    // K korunur; C, M, Y toplamı kalan paya orantılı indirilir (aşağı yuvarlama
+    // sınırın aşılmamasını garanti eder)
+    template <typename T>
+    void enforce(T* px, size_t count, uint32_t limit) {
+        for (size_t i = 0; i < count; ++i) {
+            T* p = px + i * 4;
+            const uint32_t cmy = uint32_t(p[0]) + p[1] + p[2];
+            // Yalnızca K sınırı aşıyorsa azaltılacak C, M, Y yoktur
+            if (cmy + p[3] <= limit || cmy == 0) continue;
+            const uint32_t allowed = p[3] >= limit ? 0 : limit - p[3];
+            for (size_t c = 0; c < 3; ++c) {
+                p[c] = static_cast<T>(uint64_t(p[c]) * allowed / cmy);
+            }
+        }
+    }
+
+    template <typename T>
+    void histogram(const T* px, size_t count, InkStats& stats) {
+        constexpr unsigned shift = sizeof(T) == 2 ? 8 : 0;
+        for (size_t i = 0; i < count; ++i) {
+            const T* p = px + i * 4;
+            ++stats.histogram[0][p[0] >> shift];
+            ++stats.histogram[1][p[1] >> shift];
+            ++stats.histogram[2][p[2] >> shift];
+            ++stats.histogram[3][p[3] >> shift];
+        }
+    }
+
+    template <typename T>
+    void accumulate(T* px, size_t count, size_t firstPixel, uint32_t sampleMax,
+                    const InkOptions& options, InkStats& stats) {
+        const double percent = clampTacLimit(options.tacLimit);
+        const uint32_t limit = percent > 0 ? static_cast<uint32_t>(percent / 100.0 * sampleMax) : UINT32_MAX;
+
+        Reduction r;
+        reduce(px, count, limit, r);
+        const uint64_t over = r.over;
+        if (options.enforceTacLimit && over) {
+            // Yalnızca sınırı aşan parçalar ikinci kez okunur (hâlâ önbellekte)
+            enforce(px, count, limit);
+            r = Reduction();
+            reduce(px, count, limit, r);
+        }
+
+        InkStats part;
+        part.pixels = count;
+        part.sampleMax = sampleMax;
+        for (size_t c = 0; c < 4; ++c) {
+            part.channelSum[c] = r.sum[c];
+            part.channelMax[c] = r.max[c];
+        }
+        part.maxTac = r.maxTac;
+        part.maxTacPixel = firstPixel + r.maxTacAt;
+        part.overLimitPixels = over;
+        if (options.histograms) histogram(px, count, part);
+        stats.merge(part);
+    }
+}
+
+double clampTacLimit(double percent) {
+    // NaN ve negatifler sınır yok sayılır
+    if (!(percent > 0.0)) return 0.0;
+    return std::min(percent, 400.0);
+}
+
+double InkStats::averageCoverage(size_t channel) const {
+    if (!pixels || !sampleMax || channel >= 4) return 0.0;
+    return 100.0 * static_cast<double>(channelSum[channel]) / (static_cast<double>(pixels) * sampleMax);
+}
+
+double InkStats::averageTac() const {
+    double total = 0.0;
+    for (size_t c = 0; c < 4; ++c) total += averageCoverage(c);
+    return total;
+}
+
+double InkStats::maxTacPercent() const {
+    return sampleMax ? 100.0 * maxTac / sampleMax : 0.0;
+}
+
+void InkStats::merge(const InkStats& other) {
+    if (other.pixels == 0) return;
+    if (pixels == 0 || other.maxTac > maxTac || (other.maxTac == maxTac && other.maxTacPixel < maxTacPixel)) {
+        maxTac = other.maxTac;
+        maxTacPixel = other.maxTacPixel;
+    }
+    pixels += other.pixels;
+    sampleMax = other.sampleMax;
+    overLimitPixels += other.overLimitPixels;
+    for (size_t c = 0; c < 4; ++c) {
+        channelSum[c] += other.channelSum[c];
+        channelMax[c] = std::max(channelMax[c], other.channelMax[c]);
+        for (size_t bin = 0; bin < 256; ++bin) histogram[c][bin] += other.histogram[c][bin];
+    }
+}
+
+void accumulateInk(void* cmyk, PixelFormat format, size_t pixelCount, size_t firstPixel,
+                   const InkOptions& options, InkStats& stats) {
+    if (pixelCount == 0) return;
+    if (format == PixelFormat::CMYK16) {
+        accumulate(static_cast<uint16_t*>(cmyk), pixelCount, firstPixel, 65535, options, stats);
+    } else if (format == PixelFormat::CMYK8) {
+        accumulate(static_cast<uint8_t*>(cmyk), pixelCount, firstPixel, 255, options, stats);
+    }
+}
@@ -0,0 +1,147 @@
+#include "color/Instrumentation.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    // Trace'de okunabilir olması için thread'lere küçük, kalıcı numaralar ver
+    uint32_t currentThreadNumber() {
+        static std::atomic<uint32_t> next{1};
+        thread_local uint32_t number = next.fetch_add(1, std::memory_order_relaxed);
+        return number;
+    }
+
+    void updateMax(std::atomic<uint64_t>& target, uint64_t value) {
+        uint64_t current = target.load(std::memory_order_relaxed);
+        while (value > current &&
+               !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+}
+
+Instrumentation::Instrumentation()
+    : epoch(std::chrono::steady_clock::now()), maxEvents(0) {}
+
+void Instrumentation::setTracing(bool on, size_t limit) {
+    {
+        std::lock_guard<std::mutex> lock(traceMutex);
+        maxEvents = limit;
+        if (on) events.reserve(std::min<size_t>(limit, 4096));
+    }
+    tracingFlag.store(on, std::memory_order_relaxed);
+    if (on) setEnabled(true);
+}
+
+void Instrumentation::record(Stage stage, std::chrono::steady_clock::time_point start,
+                             std::chrono::steady_clock::time_point end) {
+    const uint64_t nanos = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+
+    AtomicStage& s = stages[static_cast<size_t>(stage)];
+    s.calls.fetch_add(1, std::memory_order_relaxed);
+    s.totalNanos.fetch_add(nanos, std::memory_order_relaxed);
+    updateMax(s.maxNanos, nanos);
+
+    if (!tracing()) return;
+
+    TraceEvent event;
+    event.stage = stage;
+    event.thread = currentThreadNumber();
+    event.durationMicros = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    // epoch reset'te aynı kilit altında değişir
+    std::lock_guard<std::mutex> lock(traceMutex);
+    event.startMicros = std::chrono::duration_cast<std::chrono::microseconds>(start - epoch).count();
+    if (events.size() < maxEvents) events.push_back(event);
+}
+
+void Instrumentation::addPixels(uint64_t count, uint64_t inBytes, uint64_t outBytes) {
+    if (!enabled()) return;
+    pixels.fetch_add(count, std::memory_order_relaxed);
+    inputBytes.fetch_add(inBytes, std::memory_order_relaxed);
+    outputBytes.fetch_add(outBytes, std::memory_order_relaxed);
+}
+
+void Instrumentation::addTiffBytes(uint64_t bytes) {
+    if (!enabled()) return;
+    tiffBytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void Instrumentation::addAllocation(uint64_t bytes) {
+    if (!enabled()) return;
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+InstrumentationStats Instrumentation::snapshot() const {
+    InstrumentationStats result;
+    for (size_t i = 0; i < kStageCount; ++i) {
+        result.stages[i].calls = stages[i].calls.load(std::memory_order_relaxed);
+        result.stages[i].totalNanos = stages[i].totalNanos.load(std::memory_order_relaxed);
+        result.stages[i].maxNanos = stages[i].maxNanos.load(std::memory_order_relaxed);
+    }
+    result.pixels = pixels.load(std::memory_order_relaxed);
+    result.inputBytes = inputBytes.load(std::memory_order_relaxed);
+    result.outputBytes = outputBytes.load(std::memory_order_relaxed);
+    result.tiffBytes = tiffBytes.load(std::memory_order_relaxed);
+    result.allocations = allocations.load(std::memory_order_relaxed);
+    result.allocatedBytes = allocatedBytes.load(std::memory_order_relaxed);
+    return result;
+}
+
+void Instrumentation::reset() {
+    for (AtomicStage& s : stages) {
+        s.calls = 0;
+        s.totalNanos = 0;
+        s.maxNanos = 0;
+    }
+    pixels = 0;
+    inputBytes = 0;
+    outputBytes = 0;
+    tiffBytes = 0;
+    allocations = 0;
+    allocatedBytes = 0;
+
+    std::lock_guard<std::mutex> lock(traceMutex);
+    events.clear();
+    epoch = std::chrono::steady_clock::now();
+}
+
+std::string Instrumentation::chromeTraceJson() const {
+    std::lock_guard<std::mutex> lock(traceMutex);
+    std::ostringstream out;
+    out << "{\"traceEvents\":[";
+    for (size_t i = 0; i < events.size(); ++i) {
+        const TraceEvent& e = events[i];
+        if (i) out << ',';
+        // "X" = süresi belli tam olay
+        out << "{\"name\":\"" << stageName(e.stage) << "\",\"cat\":\"color\",\"ph\":\"X\""
+            << ",\"ts\":" << e.startMicros << ",\"dur\":" << e.durationMicros
+            << ",\"pid\":1,\"tid\":" << e.thread << '}';
+    }
+    out << "],\"displayTimeUnit\":\"ms\"}";
+    return out.str();
+}
+
+bool Instrumentation::writeChromeTrace(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Trace dosyası oluşturulamadı: " << path << std::endl;
+        return false;
+    }
+    file << chromeTraceJson();
+    return static_cast<bool>(file);
+}
+
+const char* Instrumentation::stageName(Stage stage) {
+    switch (stage) {
+        case Stage::ProfileOpen:      return "profile_open";
+        case Stage::TransformBuild:   return "transform_build";
+        case Stage::TransformExecute: return "transform_execute";
+        case Stage::ImageDecode:      return "image_decode";
+        case Stage::TiffWrite:        return "tiff_write";
+        case Stage::Count:            break;
+    }
+    return "unknown";
+}
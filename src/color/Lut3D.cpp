@@ -0,0 +1,487 @@
+#include "color/Lut3D.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#include <immintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define LUT3D_AVX2 1
+#endif
+#endif
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define LUT3D_NEON 1
+#endif
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace {
+    constexpr size_t kAlignment = 64;
+    constexpr size_t kBlock = 8;     // çekirdek başına piksel
+    constexpr unsigned kMaxGridPoints = 256;
+
+    float* alignedFloats(size_t count) {
+        size_t bytes = (count * sizeof(float) + kAlignment - 1) / kAlignment * kAlignment;
+#ifdef _WIN32
+        return static_cast<float*>(_aligned_malloc(bytes, kAlignment));
+#else
+        return static_cast<float*>(std::aligned_alloc(kAlignment, bytes));
+#endif
+    }
+
+    void alignedFree(const void* p) {
+#ifdef _WIN32
+        _aligned_free(const_cast<void*>(p));
+#else
+        std::free(const_cast<void*>(p));
+#endif
+    }
+
+    // Düğüm dizinleri: (r * N + g) * N + b
+    struct Grid {
+        const float* planes;
+        size_t planeStride;
+        unsigned n;
+    };
+
+    // Tetrahedral interpolasyon. Küp, kesirlerin büyüklük sırasına göre altı
+    // dörtyüzlüye ayrılır; sonuç dört köşenin ağırlıklı toplamıdır:
+    //   (1 - f1) v000 + (f1 - f2) v1 + (f2 - f3) v2 + f3 v111
+    // v1 en büyük kesrin eksenindeki köşe, v2 en küçük kesrin ekseni hariç
+    // diğer iki eksenin köşesidir. Eşitliklerde hangi köşenin seçildiği önemsiz,
+    // çünkü ilgili ağırlık sıfırdır; yine de SIMD yollarıyla aynı kural izlenir.
+    void tetraScalar(const Grid& grid, const float* r, const float* g, const float* b,
+                     size_t count, float* out) {
+        const int n = static_cast<int>(grid.n);
+        const int sR = n * n, sG = n, sB = 1, sAll = sR + sG + sB;
+        const float maxIndex = static_cast<float>(n - 2);
+
+        for (size_t i = 0; i < count; ++i) {
+            float ir = std::min(std::floor(r[i]), maxIndex);
+            float ig = std::min(std::floor(g[i]), maxIndex);
+            float ib = std::min(std::floor(b[i]), maxIndex);
+            float fr = r[i] - ir, fg = g[i] - ig, fb = b[i] - ib;
+            int base = static_cast<int>(ir) * sR + static_cast<int>(ig) * sG + static_cast<int>(ib);
+
+            bool rGeG = fr >= fg, rGeB = fr >= fb, gGeB = fg >= fb;
+            int off1 = (rGeG && rGeB) ? sR : (!rGeG && gGeB) ? sG : sB;
+            int off2 = sAll - ((rGeB && gGeB) ? sB : (rGeG && !gGeB) ? sG : sR);
+
+            float fmax = std::max(fr, std::max(fg, fb));
+            float fmin = std::min(fr, std::min(fg, fb));
+            float fmid = fr + fg + fb - fmax - fmin;
+            float w0 = 1.0f - fmax, w1 = fmax - fmid, w2 = fmid - fmin, w3 = fmin;
+
+            for (int c = 0; c < 4; ++c) {
+                const float* p = grid.planes + c * grid.planeStride + base;
+                out[c * kBlock + i] = w0 * p[0] + w1 * p[off1] + w2 * p[off2] + w3 * p[sAll];
+            }
+        }
+    }
+
+#if defined(LUT3D_AVX2)
+    __attribute__((target("avx2,fma")))
+    void tetraAvx2(const Grid& grid, const float* r, const float* g, const float* b,
+                   size_t count, float* out) {
+        if (count < kBlock) {
+            tetraScalar(grid, r, g, b, count, out);
+            return;
+        }
+        const int n = static_cast<int>(grid.n);
+        const __m256i sR = _mm256_set1_epi32(n * n);
+        const __m256i sG = _mm256_set1_epi32(n);
+        const __m256i sB = _mm256_set1_epi32(1);
+        const __m256i sAll = _mm256_set1_epi32(n * n + n + 1);
+        const __m256 maxIndex = _mm256_set1_ps(static_cast<float>(n - 2));
+
+        __m256 vr = _mm256_loadu_ps(r), vg = _mm256_loadu_ps(g), vb = _mm256_loadu_ps(b);
+        __m256 ir = _mm256_min_ps(_mm256_floor_ps(vr), maxIndex);
+        __m256 ig = _mm256_min_ps(_mm256_floor_ps(vg), maxIndex);
+        __m256 ib = _mm256_min_ps(_mm256_floor_ps(vb), maxIndex);
+        __m256 fr = _mm256_sub_ps(vr, ir), fg = _mm256_sub_ps(vg, ig), fb = _mm256_sub_ps(vb, ib);
+
+        __m256i base = _mm256_add_epi32(
+            _mm256_add_epi32(_mm256_mullo_epi32(_mm256_cvttps_epi32(ir), sR),
+                             _mm256_mullo_epi32(_mm256_cvttps_epi32(ig), sG)),
+            _mm256_cvttps_epi32(ib));
+
+        __m256i rGeG = _mm256_castps_si256(_mm256_cmp_ps(fr, fg, _CMP_GE_OQ));
+        __m256i rGeB = _mm256_castps_si256(_mm256_cmp_ps(fr, fb, _CMP_GE_OQ));
+        __m256i gGeB = _mm256_castps_si256(_mm256_cmp_ps(fg, fb, _CMP_GE_OQ));
+
+        // off1: en büyük kesrin ekseni
+        __m256i maxIsR = _mm256_and_si256(rGeG, rGeB);
+        __m256i maxIsG = _mm256_andnot_si256(rGeG, gGeB);
+        __m256i off1 = _mm256_blendv_epi8(_mm256_blendv_epi8(sB, sG, maxIsG), sR, maxIsR);
+        // off2: en küçük kesrin ekseni hariç ikisi
+        __m256i minIsB = _mm256_and_si256(rGeB, gGeB);
+        __m256i minIsG = _mm256_andnot_si256(gGeB, rGeG);
+        __m256i minAxis = _mm256_blendv_epi8(_mm256_blendv_epi8(sR, sG, minIsG), sB, minIsB);
+        __m256i off2 = _mm256_sub_epi32(sAll, minAxis);
+
+        __m256i i0 = base;
+        __m256i i1 = _mm256_add_epi32(base, off1);
+        __m256i i2 = _mm256_add_epi32(base, off2);
+        __m256i i3 = _mm256_add_epi32(base, sAll);
+
+        __m256 fmax = _mm256_max_ps(fr, _mm256_max_ps(fg, fb));
+        __m256 fmin = _mm256_min_ps(fr, _mm256_min_ps(fg, fb));
+        __m256 fmid = _mm256_sub_ps(_mm256_add_ps(fr, _mm256_add_ps(fg, fb)), _mm256_add_ps(fmax, fmin));
+        __m256 w0 = _mm256_sub_ps(_mm256_set1_ps(1.0f), fmax);
+        __m256 w1 = _mm256_sub_ps(fmax, fmid);
+        __m256 w2 = _mm256_sub_ps(fmid, fmin);
+        __m256 w3 = fmin;
+
+        for (int c = 0; c < 4; ++c) {
+            const float* p = grid.planes + c * grid.planeStride;
+            __m256 acc = _mm256_mul_ps(w0, _mm256_i32gather_ps(p, i0, 4));
+            acc = _mm256_fmadd_ps(w1, _mm256_i32gather_ps(p, i1, 4), acc);
+            acc = _mm256_fmadd_ps(w2, _mm256_i32gather_ps(p, i2, 4), acc);
+            acc = _mm256_fmadd_ps(w3, _mm256_i32gather_ps(p, i3, 4), acc);
+            _mm256_storeu_ps(out + c * kBlock, acc);
+        }
+    }
+#endif
+
+#if defined(LUT3D_NEON)
+    // NEON'da gather yok: dizin ve ağırlıklar vektörde, köşe okumaları skaler
+    void tetraNeon4(const Grid& grid, const float* r, const float* g, const float* b, float* out) {
+        const int n = static_cast<int>(grid.n);
+        const int32x4_t sR = vdupq_n_s32(n * n);
+        const int32x4_t sG = vdupq_n_s32(n);
+        const int32x4_t sB = vdupq_n_s32(1);
+        const int32x4_t sAll = vdupq_n_s32(n * n + n + 1);
+        const float32x4_t maxIndex = vdupq_n_f32(static_cast<float>(n - 2));
+
+        float32x4_t vr = vld1q_f32(r), vg = vld1q_f32(g), vb = vld1q_f32(b);
+        float32x4_t ir = vminq_f32(vrndmq_f32(vr), maxIndex);
+        float32x4_t ig = vminq_f32(vrndmq_f32(vg), maxIndex);
+        float32x4_t ib = vminq_f32(vrndmq_f32(vb), maxIndex);
+        float32x4_t fr = vsubq_f32(vr, ir), fg = vsubq_f32(vg, ig), fb = vsubq_f32(vb, ib);
+
+        int32x4_t base = vaddq_s32(vmlaq_s32(vmulq_s32(vcvtq_s32_f32(ir), sR), vcvtq_s32_f32(ig), sG),
+                                   vcvtq_s32_f32(ib));
+
+        uint32x4_t rGeG = vcgeq_f32(fr, fg), rGeB = vcgeq_f32(fr, fb), gGeB = vcgeq_f32(fg, fb);
+        uint32x4_t maxIsR = vandq_u32(rGeG, rGeB);
+        uint32x4_t maxIsG = vbicq_u32(gGeB, rGeG);
+        int32x4_t off1 = vbslq_s32(maxIsR, sR, vbslq_s32(maxIsG, sG, sB));
+        uint32x4_t minIsB = vandq_u32(rGeB, gGeB);
+        uint32x4_t minIsG = vbicq_u32(rGeG, gGeB);
+        int32x4_t off2 = vsubq_s32(sAll, vbslq_s32(minIsB, sB, vbslq_s32(minIsG, sG, sR)));
+
+        float32x4_t fmax = vmaxq_f32(fr, vmaxq_f32(fg, fb));
+        float32x4_t fmin = vminq_f32(fr, vminq_f32(fg, fb));
+        float32x4_t fmid = vsubq_f32(vaddq_f32(fr, vaddq_f32(fg, fb)), vaddq_f32(fmax, fmin));
+        float32x4_t w0 = vsubq_f32(vdupq_n_f32(1.0f), fmax);
+        float32x4_t w1 = vsubq_f32(fmax, fmid);
+        float32x4_t w2 = vsubq_f32(fmid, fmin);
+        float32x4_t w3 = fmin;
+
+        int32_t i0[4], i1[4], i2[4], i3[4];
+        vst1q_s32(i0, base);
+        vst1q_s32(i1, vaddq_s32(base, off1));
+        vst1q_s32(i2, vaddq_s32(base, off2));
+        vst1q_s32(i3, vaddq_s32(base, sAll));
+
+        for (int c = 0; c < 4; ++c) {
+            const float* p = grid.planes + c * grid.planeStride;
+            float v0[4], v1[4], v2[4], v3[4];
+            for (int k = 0; k < 4; ++k) {
+                v0[k] = p[i0[k]];
+                v1[k] = p[i1[k]];
+                v2[k] = p[i2[k]];
+                v3[k] = p[i3[k]];
+            }
+            float32x4_t acc = vmulq_f32(w0, vld1q_f32(v0));
+            acc = vfmaq_f32(acc, w1, vld1q_f32(v1));
+            acc = vfmaq_f32(acc, w2, vld1q_f32(v2));
+            acc = vfmaq_f32(acc, w3, vld1q_f32(v3));
+            vst1q_f32(out + c * kBlock, acc);
+        }
+    }
+
+    void tetraNeon(const Grid& grid, const float* r, const float* g, const float* b,
+                   size_t count, float* out) {
+        if (count < kBlock) {
+            tetraScalar(grid, r, g, b, count, out);
+            return;
+        }
+        tetraNeon4(grid, r, g, b, out);
+        // İkinci yarı: çıktı düzlemleri kBlock aralıklı olduğundan +4 kaydırılır
+        tetraNeon4(grid, r + 4, g + 4, b + 4, out + 4);
+    }
+#endif
+
+    using TetraKernel = void (*)(const Grid&, const float*, const float*, const float*, size_t, float*);
+
+    struct Kernel {
+        const char* name;
+        TetraKernel run;
+    };
+
+    Kernel selectKernel() {
+#if defined(LUT3D_AVX2)
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return {"avx2", tetraAvx2};
+#endif
+#if defined(LUT3D_NEON)
+        return {"neon", tetraNeon};
+#endif
+        return {"scalar", tetraScalar};
+    }
+
+    const Kernel& kernel() {
+        static const Kernel selected = selectKernel();
+        return selected;
+    }
+
+    // Girdi pikselini ızgara koordinatına çevir
+    template <typename In>
+    void loadBlock(const In* in, size_t count, float scale, float* r, float* g, float* b) {
+        using Sample = typename PixelTraits<In>::Sample;
+        const Sample* samples = reinterpret_cast<const Sample*>(in);
+        constexpr size_t channels = PixelTraits<In>::channels;
+        for (size_t i = 0; i < count; ++i) {
+            r[i] = samples[i * channels + 0] * scale;
+            g[i] = samples[i * channels + 1] * scale;
+            b[i] = samples[i * channels + 2] * scale;
+        }
+    }
+
+    // Düğümler 0..65535 ölçeğinde; çıktı bit derinliği T'den gelir.
+    // Kanal c, out[c][i * step] konumuna yazılır: bitişik çıktıda out[c] = base + c
+    // ve step = 4, düzlemsel çıktıda out[c] = düzlem ve step = 1.
+    template <typename T>
+    void storeBlock(const float* values, size_t count, T* const out[4], size_t step) {
+        constexpr float divisor = sizeof(T) == 1 ? 257.0f : 1.0f;
+        constexpr float outMax = sizeof(T) == 1 ? 255.0f : 65535.0f;
+        for (size_t c = 0; c < 4; ++c) {
+            const float* channel = values + c * kBlock;
+            T* target = out[c];
+            for (size_t i = 0; i < count; ++i) {
+                float v = channel[i] / divisor;
+                v = std::min(std::max(v, 0.0f), outMax);
+                target[i * step] = static_cast<T>(v + 0.5f);
+            }
+        }
+    }
+
+    // Girdi düzeni ve çıktı örnek tipi derleme zamanında sabit; döngüde
+    // format kontrolü yoktur
+    template <typename In, typename T>
+    void runBlocks(const Grid& grid, const In* input, T* const channels[4], size_t step,
+                   size_t pixelCount) {
+        const TetraKernel tetra = kernel().run;
+        const float scale = static_cast<float>(grid.n - 1) / PixelTraits<In>::maxValue;
+
+        alignas(32) float r[kBlock], g[kBlock], b[kBlock];
+        alignas(32) float values[4 * kBlock];
+
+        for (size_t begin = 0; begin < pixelCount; begin += kBlock) {
+            const size_t count = std::min(kBlock, pixelCount - begin);
+            loadBlock(input + begin, count, scale, r, g, b);
+            tetra(grid, r, g, b, count, values);
+
+            const size_t offset = begin * step;
+            T* const out[4] = {channels[0] + offset, channels[1] + offset,
+                               channels[2] + offset, channels[3] + offset};
+            storeBlock(values, count, out, step);
+        }
+    }
+
+    template <typename In, typename T>
+    void runBlocks(const Grid& grid, const void* input, void* const channels[4], size_t step,
+                   size_t pixelCount) {
+        T* const out[4] = {static_cast<T*>(channels[0]), static_cast<T*>(channels[1]),
+                           static_cast<T*>(channels[2]), static_cast<T*>(channels[3])};
+        runBlocks(grid, static_cast<const In*>(input), out, step, pixelCount);
+    }
+}
+
+Lut3D::Lut3D() : grid(0), planeStride(0), planes(nullptr) {}
+
+Lut3D::~Lut3D() = default;
+
+size_t Lut3D::memoryBytes() const {
+    return planeStride * 4 * sizeof(float);
+}
+
+size_t Lut3D::planeStrideFor(unsigned gridPoints) {
+    const size_t count = static_cast<size_t>(gridPoints) * gridPoints * gridPoints;
+    return (count + 15) / 16 * 16;
+}
+
+bool Lut3D::assign(unsigned gridPoints, size_t stride, const float* data,
+                   std::shared_ptr<const void> owner) {
+    if (gridPoints < 2 || gridPoints > kMaxGridPoints || !data ||
+        stride != planeStrideFor(gridPoints) ||
+        reinterpret_cast<uintptr_t>(data) % kAlignment != 0) {
+        return false;
+    }
+    storage = std::move(owner);
+    planes = data;
+    planeStride = stride;
+    grid = gridPoints;
+    return true;
+}
+
+bool Lut3D::build(cmsHTRANSFORM rgb16ToCmyk16, unsigned gridPoints) {
+    if (!rgb16ToCmyk16 || gridPoints < 2 || gridPoints > kMaxGridPoints) {
+        std::cerr << "Geçersiz LUT ızgarası: " << gridPoints << std::endl;
+        return false;
+    }
+
+    const size_t n = gridPoints;
+    const size_t count = n * n * n;
+
+    // Tüm düğümleri tek cmsDoTransform çağrısıyla örnekle
+    std::vector<RGB16> samples(count);
+    std::vector<CMYK16> results(count);
+    for (size_t r = 0; r < n; ++r)
+        for (size_t g = 0; g < n; ++g)
+            for (size_t b = 0; b < n; ++b) {
+                RGB16& s = samples[(r * n + g) * n + b];
+                s.r = static_cast<uint16_t>((r * 65535 + (n - 1) / 2) / (n - 1));
+                s.g = static_cast<uint16_t>((g * 65535 + (n - 1) / 2) / (n - 1));
+                s.b = static_cast<uint16_t>((b * 65535 + (n - 1) / 2) / (n - 1));
+            }
+    cmsDoTransform(rgb16ToCmyk16, samples.data(), results.data(), static_cast<cmsUInt32Number>(count));
+
+    // Düzlemler hizalı başlasın diye her biri 16 float'ın katına yuvarlanır
+    const size_t stride = planeStrideFor(gridPoints);
+    float* data = alignedFloats(stride * 4);
+    if (!data) {
+        std::cerr << "LUT için bellek ayrılamadı" << std::endl;
+        return false;
+    }
+    std::shared_ptr<const void> owner(data, alignedFree);
+    std::fill(data, data + stride * 4, 0.0f);
+    for (size_t i = 0; i < count; ++i) {
+        data[0 * stride + i] = results[i].c;
+        data[1 * stride + i] = results[i].m;
+        data[2 * stride + i] = results[i].y;
+        data[3 * stride + i] = results[i].k;
+    }
+
+    return assign(gridPoints, stride, data, std::move(owner));
+}
+
+bool Lut3D::supports(PixelFormat inputFormat, PixelFormat outputFormat) {
+    bool in = inputFormat == PixelFormat::RGB8 || inputFormat == PixelFormat::RGBA8 ||
+              inputFormat == PixelFormat::RGB16;
+    bool out = outputFormat == PixelFormat::CMYK8 || outputFormat == PixelFormat::CMYK16;
+    return in && out;
+}
+
+bool Lut3D::apply(const void* input, PixelFormat inputFormat,
+                  void* output, PixelFormat outputFormat,
+                  size_t pixelCount) const {
+    const size_t sample = outputFormat == PixelFormat::CMYK16 ? 2 : 1;
+    uint8_t* base = static_cast<uint8_t*>(output);
+    void* const channels[4] = {base, base + sample, base + 2 * sample, base + 3 * sample};
+    return run(input, inputFormat, channels, 4, outputFormat, pixelCount);
+}
+
+bool Lut3D::applyPlanar(const void* input, PixelFormat inputFormat,
+                        const CMYKPlanes& output, PixelFormat outputFormat,
+                        size_t pixelCount) const {
+    return run(input, inputFormat, output.planes, 1, outputFormat, pixelCount);
+}
+
+bool Lut3D::run(const void* input, PixelFormat inputFormat,
+                void* const channels[4], size_t step, PixelFormat outputFormat,
+                size_t pixelCount) const {
+    if (empty() || !supports(inputFormat, outputFormat)) return false;
+
+    // Format çağrı başına bir kez seçilir; blok döngüsü tipli çekirdekte
+    const Grid g{planes, planeStride, grid};
+    const bool wide = outputFormat == PixelFormat::CMYK16;
+    switch (inputFormat) {
+        case PixelFormat::RGB8:
+            if (wide) runBlocks<RGB8, uint16_t>(g, input, channels, step, pixelCount);
+            else runBlocks<RGB8, uint8_t>(g, input, channels, step, pixelCount);
+            break;
+        case PixelFormat::RGBA8:
+            if (wide) runBlocks<RGBA8, uint16_t>(g, input, channels, step, pixelCount);
+            else runBlocks<RGBA8, uint8_t>(g, input, channels, step, pixelCount);
+            break;
+        default:
+            if (wide) runBlocks<RGB16, uint16_t>(g, input, channels, step, pixelCount);
+            else runBlocks<RGB16, uint8_t>(g, input, channels, step, pixelCount);
+            break;
+    }
+    return true;
+}
+
+template <typename In, typename Out>
+void Lut3D::apply(const In* input, Out* output, size_t pixelCount) const {
+    using Sample = typename PixelTraits<Out>::Sample;
+    Sample* base = reinterpret_cast<Sample*>(output);
+    Sample* const channels[4] = {base, base + 1, base + 2, base + 3};
+    runBlocks(Grid{planes, planeStride, grid}, input, channels, 4, pixelCount);
+}
+
+// Converter<In, Out>'un kullandığı format çiftleri
+template void Lut3D::apply(const RGB8*, CMYK8*, size_t) const;
+template void Lut3D::apply(const RGB8*, CMYK16*, size_t) const;
+template void Lut3D::apply(const RGBA8*, CMYK8*, size_t) const;
+template void Lut3D::apply(const RGBA8*, CMYK16*, size_t) const;
+template void Lut3D::apply(const RGB16*, CMYK8*, size_t) const;
+template void Lut3D::apply(const RGB16*, CMYK16*, size_t) const;
+
+LutAccuracy Lut3D::measureAccuracy(cmsHTRANSFORM rgb16ToCmyk16, cmsHPROFILE cmykProfile,
+                                   unsigned samplesPerAxis) const {
+    LutAccuracy accuracy;
+    if (empty() || !rgb16ToCmyk16 || !cmykProfile || samplesPerAxis == 0) return accuracy;
+
+    // Örnekler (i + 0.5) / s konumlarındadır; ızgara düğümlerine nadiren denk gelir
+    const size_t s = samplesPerAxis;
+    const size_t count = s * s * s;
+    std::vector<uint16_t> axis(s);
+    for (size_t i = 0; i < s; ++i) axis[i] = static_cast<uint16_t>(((2 * i + 1) * 65535) / (2 * s));
+
+    std::vector<RGB16> rgb(count);
+    for (size_t r = 0; r < s; ++r)
+        for (size_t g = 0; g < s; ++g)
+            for (size_t b = 0; b < s; ++b)
+                rgb[(r * s + g) * s + b] = RGB16{axis[r], axis[g], axis[b]};
+
+    std::vector<CMYK16> reference(count), approximated(count);
+    cmsDoTransform(rgb16ToCmyk16, rgb.data(), reference.data(), static_cast<cmsUInt32Number>(count));
+    apply(rgb.data(), PixelFormat::RGB16, approximated.data(), PixelFormat::CMYK16, count);
+
+    // CMYK -> Lab, çıktı profilinin kendi tanımına göre
+    cmsHPROFILE lab = cmsCreateLab4Profile(NULL);
+    cmsHTRANSFORM toLab = cmsCreateTransform(cmykProfile, TYPE_CMYK_16, lab, TYPE_Lab_DBL,
+                                             INTENT_RELATIVE_COLORIMETRIC, 0);
+    cmsCloseProfile(lab);
+    if (!toLab) {
+        std::cerr << "Lab transform'u oluşturulamadı" << std::endl;
+        return accuracy;
+    }
+    std::vector<cmsCIELab> labReference(count), labApproximated(count);
+    cmsDoTransform(toLab, reference.data(), labReference.data(), static_cast<cmsUInt32Number>(count));
+    cmsDoTransform(toLab, approximated.data(), labApproximated.data(), static_cast<cmsUInt32Number>(count));
+    cmsDeleteTransform(toLab);
+
+    double sum = 0;
+    for (size_t i = 0; i < count; ++i) {
+        double dE = cmsCIE2000DeltaE(&labReference[i], &labApproximated[i], 1, 1, 1);
+        accuracy.maxDeltaE = std::max(accuracy.maxDeltaE, dE);
+        sum += dE;
+    }
+    accuracy.samples = count;
+    accuracy.meanDeltaE = sum / count;
+    return accuracy;
+}
+
+const char* Lut3D::kernelName() {
+    return kernel().name;
+}
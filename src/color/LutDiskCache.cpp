@@ -0,0 +1,117 @@
+#include "color/LutDiskCache.hpp"
+#include "color/MappedFile.hpp"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <system_error>
+
+namespace {
+    const char kMagic[8] = {'C', 'L', 'R', 'L', 'U', 'T', '3', 'D'};
+    constexpr uint32_t kByteOrderMark = 0x01020304;
+
+    // Düzlemlerin eşlemede 64 bayt hizalı başlaması için başlık tam 64 bayt
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrder;
+        uint8_t input[16];
+        uint8_t output[16];
+        uint32_t intent;
+        uint32_t flags;
+        uint32_t gridPoints;
+        uint32_t floatBytes;
+    };
+    static_assert(sizeof(FileHeader) == 64, "LUT dosya başlığı 64 bayt olmalı");
+
+    FileHeader headerFor(const LutCacheKey& key) {
+        FileHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = LutDiskCache::kFormatVersion;
+        header.byteOrder = kByteOrderMark;
+        std::memcpy(header.input, key.input.data(), 16);
+        std::memcpy(header.output, key.output.data(), 16);
+        header.intent = key.intent;
+        header.flags = key.flags;
+        header.gridPoints = key.gridPoints;
+        header.floatBytes = sizeof(float);
+        return header;
+    }
+
+    // Anahtarın FNV-1a özeti; dosya adı içindir, asıl doğrulama başlıkta
+    uint64_t keyHash(const FileHeader& header) {
+        uint64_t hash = 1469598103934665603ull;
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&header);
+        for (size_t i = 0; i < sizeof(header); ++i) hash = (hash ^ bytes[i]) * 1099511628211ull;
+        return hash;
+    }
+}
+
+LutDiskCache::LutDiskCache(std::string dir) : directory(std::move(dir)) {}
+
+std::string LutDiskCache::pathFor(const LutCacheKey& key) const {
+    char name[48];
+    std::snprintf(name, sizeof(name), "lut_%016llx_%u.clut",
+                  static_cast<unsigned long long>(keyHash(headerFor(key))), key.gridPoints);
+    return (std::filesystem::path(directory) / name).string();
+}
+
+std::shared_ptr<const Lut3D> LutDiskCache::load(const LutCacheKey& key) const {
+    std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>();
+    if (!file->open(pathFor(key))) return nullptr;
+
+    const FileHeader expected = headerFor(key);
+    const size_t stride = Lut3D::planeStrideFor(key.gridPoints);
+    const size_t expectedSize = sizeof(FileHeader) + stride * 4 * sizeof(float);
+    if (file->size() != expectedSize || std::memcmp(file->data(), &expected, sizeof(expected)) != 0) {
+        std::cerr << "LUT cache dosyası geçersiz, yeniden oluşturulacak: " << pathFor(key) << std::endl;
+        return nullptr;
+    }
+
+    // Düğümler eşlemeden okunur; eşleme LUT'la birlikte yaşar
+    const float* planes = reinterpret_cast<const float*>(file->data() + sizeof(FileHeader));
+    std::shared_ptr<Lut3D> lut = std::make_shared<Lut3D>();
+    if (!lut->assign(key.gridPoints, stride, planes, file)) return nullptr;
+    return lut;
+}
+
+bool LutDiskCache::store(const LutCacheKey& key, const Lut3D& lut) const {
+    if (lut.empty() || lut.gridPoints() != key.gridPoints) return false;
+
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+
+    const std::string path = pathFor(key);
+    std::random_device random;
+    const std::string temporary = path + ".tmp" + std::to_string(random());
+
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            std::cerr << "LUT cache dosyası yazılamadı: " << temporary << std::endl;
+            return false;
+        }
+        const FileHeader header = headerFor(key);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(lut.planeData()),
+                   static_cast<std::streamsize>(lut.getPlaneStride() * 4 * sizeof(float)));
+        if (!file) {
+            std::cerr << "LUT cache dosyası yazılamadı: " << temporary << std::endl;
+            file.close();
+            std::filesystem::remove(temporary, ec);
+            return false;
+        }
+    }
+
+    // Aynı anda yazan başka bir worker varsa son yeniden adlandırma kazanır;
+    // içerikler aynı anahtardan üretildiği için fark etmez.
+    std::filesystem::rename(temporary, path, ec);
+    if (ec) {
+        std::filesystem::remove(temporary, ec);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,183 @@
+#include "color/ScratchArena.hpp"
+#include "color/Instrumentation.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+    constexpr size_t kAlignment = 64;
+
+    // Havuz blokları bu katlara yuvarlanır; yakın boyutlar aynı bloğu paylaşır
+    constexpr size_t kGranule = 64u * 1024;
+
+    // Kullanıcı verisinin hemen önünde, hizayı korumak için 64 bayt
+    struct alignas(kAlignment) BlockHeader {
+        ScratchArena* arena;    // heap'ten gelen küçük bloklarda nullptr
+        size_t capacity;
+    };
+    static_assert(sizeof(BlockHeader) == kAlignment, "blok başlığı 64 bayt olmalı");
+
+    thread_local ScratchArena* boundArena = nullptr;
+
+    BlockHeader* headerOf(void* block) {
+        return reinterpret_cast<BlockHeader*>(static_cast<uint8_t*>(block) - sizeof(BlockHeader));
+    }
+
+    void* rawAllocate(size_t capacity, ScratchArena* owner) {
+        size_t bytes = (sizeof(BlockHeader) + capacity + kAlignment - 1) / kAlignment * kAlignment;
+#ifdef _WIN32
+        void* raw = _aligned_malloc(bytes, kAlignment);
+#else
+        void* raw = std::aligned_alloc(kAlignment, bytes);
+#endif
+        if (!raw) return nullptr;
+        BlockHeader* header = static_cast<BlockHeader*>(raw);
+        header->arena = owner;
+        header->capacity = capacity;
+        return header + 1;
+    }
+
+    void rawFree(void* block) {
+        void* raw = headerOf(block);
+#ifdef _WIN32
+        _aligned_free(raw);
+#else
+        std::free(raw);
+#endif
+    }
+}
+
+ScratchArena::ScratchArena(size_t limit) : retainLimit(limit), instr(nullptr) {}
+
+ScratchArena::~ScratchArena() {
+    trim();
+}
+
+void* ScratchArena::allocate(size_t bytes) {
+    if (bytes < kMinPooledBytes) {
+        return rawAllocate(std::max<size_t>(bytes, 1), nullptr);
+    }
+
+    {
+        // En küçük uygun blok; çok büyük bir blok küçük isteğe harcanmasın
+        std::lock_guard<std::mutex> lock(mutex);
+        auto best = freeBlocks.end();
+        for (auto it = freeBlocks.begin(); it != freeBlocks.end(); ++it) {
+            if (it->capacity >= bytes && it->capacity <= 2 * bytes &&
+                (best == freeBlocks.end() || it->capacity < best->capacity)) {
+                best = it;
+            }
+        }
+        if (best != freeBlocks.end()) {
+            void* block = best->block;
+            counters.cachedBytes -= best->capacity;
+            ++counters.reuses;
+            freeBlocks.erase(best);
+            return block;
+        }
+    }
+
+    const size_t capacity = (bytes + kGranule - 1) / kGranule * kGranule;
+    void* block = rawAllocate(capacity, this);
+    if (!block) return nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++counters.heapAllocations;
+        counters.heapBytes += capacity;
+    }
+    if (instr) instr->addAllocation(capacity);
+    return block;
+}
+
+void* ScratchArena::reallocate(void* block, size_t bytes) {
+    if (!block) return allocate(bytes);
+    const size_t capacity = headerOf(block)->capacity;
+    if (bytes <= capacity) return block;
+
+    void* grown = allocate(bytes);
+    if (!grown) return nullptr;
+    std::memcpy(grown, block, capacity);
+    release(block);
+    return grown;
+}
+
+void ScratchArena::release(void* block) {
+    if (!block) return;
+    BlockHeader* header = headerOf(block);
+    if (header->arena) header->arena->recycle(block, header->capacity);
+    else rawFree(block);
+}
+
+void ScratchArena::recycle(void* block, size_t capacity) {
+    std::vector<void*> evicted;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // Sınır aşılıyorsa önce en eski bloklar bırakılır
+        while (!freeBlocks.empty() && counters.cachedBytes + capacity > retainLimit) {
+            evicted.push_back(freeBlocks.front().block);
+            counters.cachedBytes -= freeBlocks.front().capacity;
+            freeBlocks.erase(freeBlocks.begin());
+        }
+        if (counters.cachedBytes + capacity <= retainLimit) {
+            freeBlocks.push_back(FreeBlock{block, capacity});
+            counters.cachedBytes += capacity;
+            block = nullptr;
+        }
+    }
+    for (void* old : evicted) rawFree(old);
+    if (block) rawFree(block);
+}
+
+void ScratchArena::setRetainLimit(size_t bytes) {
+    std::vector<void*> evicted;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        retainLimit = bytes;
+        while (!freeBlocks.empty() && counters.cachedBytes > retainLimit) {
+            evicted.push_back(freeBlocks.front().block);
+            counters.cachedBytes -= freeBlocks.front().capacity;
+            freeBlocks.erase(freeBlocks.begin());
+        }
+    }
+    for (void* old : evicted) rawFree(old);
+}
+
+void ScratchArena::trim() {
+    std::vector<FreeBlock> blocks;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        blocks.swap(freeBlocks);
+        counters.cachedBytes = 0;
+    }
+    for (const FreeBlock& free : blocks) rawFree(free.block);
+}
+
+ScratchStats ScratchArena::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return counters;
+}
+
+ScratchArena::Binding::Binding(ScratchArena& arena) : previous(boundArena) {
+    boundArena = &arena;
+}
+
+ScratchArena::Binding::~Binding() {
+    boundArena = previous;
+}
+
+void* ScratchArena::threadAllocate(size_t bytes) {
+    if (boundArena) return boundArena->allocate(bytes);
+    return rawAllocate(std::max<size_t>(bytes, 1), nullptr);
+}
+
+void* ScratchArena::threadReallocate(void* block, size_t bytes) {
+    if (!block) return threadAllocate(bytes);
+    BlockHeader* header = headerOf(block);
+    if (bytes <= header->capacity) return block;
+
+    void* grown = threadAllocate(bytes);
+    if (!grown) return nullptr;
+    std::memcpy(grown, block, header->capacity);
+    release(block);
+    return grown;
+}
@@ -0,0 +1,297 @@
+#include "color/SoftProofer.hpp"
+#include "color/ThreadPool.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace {
+    // İptal kontrolü ve paralel görev boyutu (satır)
+    constexpr size_t kRowsPerTask = 32;
+
+    // Piramit bu boyuta inince durur
+    constexpr uint32_t kSmallestLevel = 16;
+
+    void deleteTransform(void* h) {
+        if (h) cmsDeleteTransform(h);
+    }
+
+    void closeProfile(void* h) {
+        if (h) cmsCloseProfile(h);
+    }
+
+    // 2x2 kutu filtresi; tek boyutlarda son satır/sütun tekrarlanır
+    void downsample(const RGBA8* src, uint32_t srcWidth, uint32_t srcHeight,
+                    RGBA8* dst, uint32_t dstWidth, uint32_t dstHeight) {
+        for (uint32_t y = 0; y < dstHeight; ++y) {
+            const RGBA8* row0 = src + static_cast<size_t>(std::min(2 * y, srcHeight - 1)) * srcWidth;
+            const RGBA8* row1 = src + static_cast<size_t>(std::min(2 * y + 1, srcHeight - 1)) * srcWidth;
+            RGBA8* out = dst + static_cast<size_t>(y) * dstWidth;
+            for (uint32_t x = 0; x < dstWidth; ++x) {
+                const uint32_t x0 = std::min(2 * x, srcWidth - 1);
+                const uint32_t x1 = std::min(2 * x + 1, srcWidth - 1);
+                const RGBA8 &a = row0[x0], &b = row0[x1], &c = row1[x0], &d = row1[x1];
+                out[x].r = static_cast<uint8_t>((a.r + b.r + c.r + d.r + 2) >> 2);
+                out[x].g = static_cast<uint8_t>((a.g + b.g + c.g + d.g + 2) >> 2);
+                out[x].b = static_cast<uint8_t>((a.b + b.b + c.b + d.b + 2) >> 2);
+                out[x].a = static_cast<uint8_t>((a.a + b.a + c.a + d.a + 2) >> 2);
+            }
+        }
+    }
+}
+
+SoftProofer::SoftProofer() : generation(0), stopping(false) {
+    worker = std::thread(&SoftProofer::workerLoop, this);
+}
+
+SoftProofer::~SoftProofer() {
+    {
+        std::lock_guard<std::mutex> lock(requestMutex);
+        stopping = true;
+        pending.reset();
+    }
+    generation.fetch_add(1, std::memory_order_acq_rel);
+    requestReady.notify_all();
+    worker.join();
+}
+
+bool SoftProofer::initialize(const std::string& sourceProfilePath,
+                             const std::string& proofProfilePath,
+                             const std::string& displayProfilePath,
+                             const SoftProofOptions& proofOptions) {
+    TransformCache& cache = TransformCache::instance();
+    CachedProfile source = cache.openProfile(sourceProfilePath);
+    if (!source) {
+        std::cerr << "Kaynak profili yüklenemedi: " << sourceProfilePath << std::endl;
+        return false;
+    }
+    CachedProfile proof = cache.openProfile(proofProfilePath);
+    if (!proof) {
+        std::cerr << "Baskı profili yüklenemedi: " << proofProfilePath << std::endl;
+        return false;
+    }
+
+    CachedProfile display;
+    if (displayProfilePath.empty()) {
+        display.handle = std::shared_ptr<void>(cmsCreate_sRGBProfile(), closeProfile);
+    } else {
+        display = cache.openProfile(displayProfilePath);
+    }
+    if (!display) {
+        std::cerr << "Ekran profili yüklenemedi: " << displayProfilePath << std::endl;
+        return false;
+    }
+    return initialize(source, proof, display, proofOptions);
+}
+
+bool SoftProofer::initialize(const CachedProfile& sourceProfile,
+                             const CachedProfile& proofProfile,
+                             const CachedProfile& displayProfile,
+                             const SoftProofOptions& proofOptions) {
+    cancel();
+    {
+        // previewLevelFor worker thread'inden de okur
+        std::lock_guard<std::mutex> lock(imageMutex);
+        options = proofOptions;
+    }
+    if (!sourceProfile || !proofProfile || !displayProfile) {
+        std::cerr << "Profil açılmamış!" << std::endl;
+        return false;
+    }
+
+    cmsUInt32Number flags = cmsFLAGS_SOFTPROOFING | cmsFLAGS_BLACKPOINTCOMPENSATION |
+                            cmsFLAGS_NOCACHE |      // render aynı anda birden çok thread'den
+                            cmsFLAGS_COPY_ALPHA;
+    if (proofOptions.gamutCheck) flags |= cmsFLAGS_GAMUTCHECK;
+
+    cmsHTRANSFORM h = cmsCreateProofingTransform(sourceProfile.get(), TYPE_RGBA_8,
+                                                 displayProfile.get(), TYPE_RGBA_8,
+                                                 proofProfile.get(),
+                                                 proofOptions.intent, proofOptions.proofingIntent, flags);
+    if (!h) {
+        std::cerr << "Prova transform'u oluşturulamadı!" << std::endl;
+        std::lock_guard<std::mutex> lock(imageMutex);
+        transform.reset();
+        return false;
+    }
+
+    // render'lar mevcut transform'u tutar; eskisi son kullanımla birlikte silinir
+    std::lock_guard<std::mutex> lock(imageMutex);
+    transform = std::shared_ptr<void>(h, deleteTransform);
+    const unsigned threads = proofOptions.threads ? proofOptions.threads : ThreadPool::hardwareThreads();
+    pool.reset();
+    if (threads > 1) pool = std::make_shared<ThreadPool>(threads - 1);
+    return true;
+}
+
+void SoftProofer::setImage(const RGBA8* pixels, uint32_t width, uint32_t height, size_t stride) {
+    cancel();
+    std::shared_ptr<std::vector<Level>> pyramid = std::make_shared<std::vector<Level>>();
+    if (pixels && width && height) {
+        if (stride == 0) stride = static_cast<size_t>(width) * sizeof(RGBA8);
+
+        Level base;
+        base.width = width;
+        base.height = height;
+        base.pixels.resize(static_cast<size_t>(width) * height);
+        for (uint32_t y = 0; y < height; ++y) {
+            std::memcpy(base.pixels.data() + static_cast<size_t>(y) * width,
+                        reinterpret_cast<const uint8_t*>(pixels) + y * stride,
+                        static_cast<size_t>(width) * sizeof(RGBA8));
+        }
+        pyramid->push_back(std::move(base));
+
+        while (pyramid->back().width > kSmallestLevel || pyramid->back().height > kSmallestLevel) {
+            const Level& previous = pyramid->back();
+            Level next;
+            next.width = (previous.width + 1) / 2;
+            next.height = (previous.height + 1) / 2;
+            next.pixels.resize(static_cast<size_t>(next.width) * next.height);
+            downsample(previous.pixels.data(), previous.width, previous.height,
+                       next.pixels.data(), next.width, next.height);
+            pyramid->push_back(std::move(next));
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(imageMutex);
+    levels = pyramid;
+}
+
+unsigned SoftProofer::levelCount() const {
+    std::lock_guard<std::mutex> lock(imageMutex);
+    return levels ? static_cast<unsigned>(levels->size()) : 0;
+}
+
+uint32_t SoftProofer::levelWidth(unsigned level) const {
+    std::lock_guard<std::mutex> lock(imageMutex);
+    return levels && level < levels->size() ? (*levels)[level].width : 0;
+}
+
+uint32_t SoftProofer::levelHeight(unsigned level) const {
+    std::lock_guard<std::mutex> lock(imageMutex);
+    return levels && level < levels->size() ? (*levels)[level].height : 0;
+}
+
+unsigned SoftProofer::levelFor(const ProofView& view) const {
+    const unsigned count = levelCount();
+    if (count == 0 || view.targetWidth == 0 || view.targetHeight == 0) return 0;
+
+    // Ekran pikseli başına düşen kaynak pikseli; seviye L 2^L kaynak pikseli birleştirir
+    const double scale = std::max(static_cast<double>(view.source.width) / view.targetWidth,
+                                  static_cast<double>(view.source.height) / view.targetHeight);
+    unsigned level = 0;
+    while (level + 1 < count && static_cast<double>(2u << level) <= scale) ++level;
+    return level;
+}
+
+unsigned SoftProofer::previewLevelFor(const ProofView& view) const {
+    const unsigned count = levelCount();
+    size_t previewPixels;
+    {
+        std::lock_guard<std::mutex> lock(imageMutex);
+        previewPixels = options.previewPixels;
+    }
+    unsigned level = levelFor(view);
+    while (level + 1 < count) {
+        const size_t w = (view.source.width >> level) + 1;
+        const size_t h = (view.source.height >> level) + 1;
+        if (w * h <= previewPixels) break;
+        ++level;
+    }
+    return level;
+}
+
+bool SoftProofer::render(unsigned level, const PixelRect& source, ProofFrame& frame,
+                         uint64_t expected) const {
+    std::shared_ptr<const std::vector<Level>> pyramid;
+    std::shared_ptr<void> h;
+    std::shared_ptr<ThreadPool> workers;
+    {
+        std::lock_guard<std::mutex> lock(imageMutex);
+        pyramid = levels;
+        h = transform;
+        workers = pool;
+    }
+    if (!h || !pyramid || level >= pyramid->size()) return false;
+    const Level& image = (*pyramid)[level];
+
+    // Kaynak dikdörtgenini seviye koordinatlarına yuvarla (dışa doğru)
+    const size_t unit = size_t(1) << level;
+    const size_t x0 = std::min<size_t>(source.x / unit, image.width);
+    const size_t y0 = std::min<size_t>(source.y / unit, image.height);
+    const size_t x1 = std::min<size_t>((source.x + source.width + unit - 1) / unit, image.width);
+    const size_t y1 = std::min<size_t>((source.y + source.height + unit - 1) / unit, image.height);
+
+    frame.generation = expected;
+    frame.level = level;
+    frame.region = PixelRect{x0, y0, x1 - x0, y1 - y0};
+    frame.pixels.resize(frame.region.width * frame.region.height);
+    if (frame.pixels.empty()) return true;
+
+    auto cancelled = [&] {
+        return expected != 0 && generation.load(std::memory_order_acquire) != expected;
+    };
+
+    const size_t columns = frame.region.width;
+    auto run = [&](size_t begin, size_t end) {
+        if (cancelled()) return;
+        cmsDoTransformLineStride(h.get(),
+                                 image.pixels.data() + (y0 + begin) * image.width + x0,
+                                 frame.pixels.data() + begin * columns,
+                                 static_cast<cmsUInt32Number>(columns),
+                                 static_cast<cmsUInt32Number>(end - begin),
+                                 static_cast<cmsUInt32Number>(image.width * sizeof(RGBA8)),
+                                 static_cast<cmsUInt32Number>(columns * sizeof(RGBA8)),
+                                 0, 0);
+    };
+
+    const size_t rows = frame.region.height;
+    if (workers && rows > kRowsPerTask) workers->parallelFor(rows, kRowsPerTask, run);
+    else {
+        for (size_t row = 0; row < rows; row += kRowsPerTask) run(row, std::min(rows, row + kRowsPerTask));
+    }
+    return !cancelled();
+}
+
+uint64_t SoftProofer::request(const ProofView& view, FrameCallback onFrame) {
+    std::unique_ptr<Pending> next(new Pending());
+    next->view = view;
+    next->onFrame = std::move(onFrame);
+
+    std::lock_guard<std::mutex> lock(requestMutex);
+    // Eski isteğin bekleyen kareleri artık gösterilmeyecek
+    next->generation = generation.fetch_add(1, std::memory_order_acq_rel) + 1;
+    const uint64_t id = next->generation;
+    pending = std::move(next);
+    requestReady.notify_one();
+    return id;
+}
+
+uint64_t SoftProofer::cancel() {
+    std::lock_guard<std::mutex> lock(requestMutex);
+    pending.reset();
+    return generation.fetch_add(1, std::memory_order_acq_rel) + 1;
+}
+
+void SoftProofer::workerLoop() {
+    for (;;) {
+        std::unique_ptr<Pending> job;
+        {
+            std::unique_lock<std::mutex> lock(requestMutex);
+            requestReady.wait(lock, [&] { return stopping || pending; });
+            if (stopping) return;
+            job = std::move(pending);
+        }
+
+        const unsigned finest = levelFor(job->view);
+        const unsigned coarsest = previewLevelFor(job->view);
+
+        // Kabadan inceye; her kare bir öncekinin üzerine çizilir
+        ProofFrame frame;
+        for (unsigned level = coarsest + 1; level-- > finest;) {
+            if (!render(level, job->view.source, frame, job->generation)) break;
+            frame.final = level == finest;
+            if (job->onFrame) job->onFrame(frame);
+            if (currentGeneration() != job->generation) break;
+        }
+    }
+}
@@ -0,0 +1,11 @@
+// stb_image uygulaması kütüphane içinde tek bir çeviri biriminde derlenir.
+// Ayırmalar ScratchArena üzerinden yapılır: thread'e bir arena bağlıysa
+// çözülmüş görüntü ve geçici buffer'lar onun havuzundan gelir.
+#include "color/ScratchArena.hpp"
+#define STBI_MALLOC(size)        ScratchArena::threadAllocate(size)
+#define STBI_REALLOC(p, size)    ScratchArena::threadReallocate(p, size)
+#define STBI_FREE(p)             ScratchArena::release(p)
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "stb_image_write.h"
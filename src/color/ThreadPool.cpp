@@ -0,0 +1,103 @@
+#include "color/ThreadPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+ThreadPool::ThreadPool(unsigned threadCount) : stopping(false) {
+    if (threadCount == 0) threadCount = hardwareThreads();
+
+    workers.reserve(threadCount);
+    for (unsigned i = 0; i < threadCount; ++i) {
+        workers.emplace_back([this] { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    cv.notify_all();
+    for (auto& worker : workers) worker.join();
+}
+
+unsigned ThreadPool::hardwareThreads() {
+    unsigned count = std::thread::hardware_concurrency();
+    return count ? count : 1;
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+    cv.notify_one();
+}
+
+void ThreadPool::workerLoop() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (stopping && tasks.empty()) return;
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, size_t chunkSize,
+                             const std::function<void(size_t, size_t)>& body) {
+    if (count == 0) return;
+    if (chunkSize == 0) chunkSize = count;
+
+    const size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+    if (chunkCount == 1 || workers.empty()) {
+        body(0, count);
+        return;
+    }
+
+    // Geç başlayan yardımcı görevler de güvenle çıkabilsin diye durum
+    // paylaşımlı tutulur; body'ye yalnızca iş kaldıysa dokunulur.
+    struct State {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::exception_ptr error;
+    };
+    auto state = std::make_shared<State>();
+    const auto* fn = &body;
+
+    auto run = [state, fn, count, chunkSize, chunkCount] {
+        for (;;) {
+            size_t chunk = state->next.fetch_add(1);
+            if (chunk >= chunkCount) return;
+
+            size_t begin = chunk * chunkSize;
+            size_t end = std::min(begin + chunkSize, count);
+            try {
+                (*fn)(begin, end);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (!state->error) state->error = std::current_exception();
+            }
+
+            if (state->done.fetch_add(1) + 1 == chunkCount) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->cv.notify_all();
+            }
+        }
+    };
+
+    size_t helpers = std::min<size_t>(workers.size(), chunkCount - 1);
+    for (size_t i = 0; i < helpers; ++i) submit(run);
+    run();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->cv.wait(lock, [&] { return state->done.load() == chunkCount; });
+    if (state->error) std::rethrow_exception(state->error);
+}
@@ -0,0 +1,582 @@
+#include "color/TiffWriter.hpp"
+#include "color/ThreadPool.hpp"
+#include <tiffio.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+
+#ifdef COLOR_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef COLOR_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#include <immintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define TIFF_AVX2 1
+#endif
+#endif
+
+namespace {
+    // Otomatik strip yüksekliği için hedef sıkıştırılmamış strip boyutu
+    constexpr size_t kTargetStripBytes = 1024 * 1024;
+
+    // Klasik TIFF'in 32-bit ofsetleri; dizinler ve ICC için pay bırakılır
+    constexpr uint64_t kClassicTiffLimit = 0xF0000000ull;
+
+    constexpr int kSamples = 4;
+
+    uint16_t tiffCompression(TiffCompression compression) {
+        switch (compression) {
+            case TiffCompression::None:    return COMPRESSION_NONE;
+            case TiffCompression::Deflate: return COMPRESSION_ADOBE_DEFLATE;
+            case TiffCompression::Zstd:    return COMPRESSION_ZSTD;
+            case TiffCompression::Lzw:     break;
+        }
+        return COMPRESSION_LZW;
+    }
+
+    // İki kaynak satırından bir piramit satırı: 2x2 kutu ortalaması, tek
+    // genişlikte son sütun tekrarlanır. Kaynak sourceWidth, çıktı
+    // (sourceWidth + 1) / 2 bitişik CMYK16 piksel.
+    void boxDownsampleScalar(const uint16_t* a, const uint16_t* b, uint32_t begin, uint32_t sourceWidth,
+                             uint16_t* out) {
+        const uint32_t outWidth = (sourceWidth + 1) / 2;
+        for (uint32_t x = begin; x < outWidth; ++x) {
+            const size_t x0 = static_cast<size_t>(2 * x) * kSamples;
+            const size_t x1 = static_cast<size_t>(std::min(2 * x + 1, sourceWidth - 1)) * kSamples;
+            for (int c = 0; c < kSamples; ++c) {
+                const uint32_t sum = uint32_t(a[x0 + c]) + a[x1 + c] + b[x0 + c] + b[x1 + c];
+                out[static_cast<size_t>(x) * kSamples + c] = static_cast<uint16_t>((sum + 2) >> 2);
+            }
+        }
+    }
+
+#if defined(TIFF_AVX2)
+    // Kaynak piksel 0..3 (iki satır) -> [çıktı 0 | çıktı 1], 32-bit örnekler.
+    // Dikey toplam 32-bit'te alınır, yatay komşular 128-bit yarılar olarak toplanır.
+    __attribute__((target("avx2")))
+    inline __m256i boxPairAvx2(const uint16_t* a, const uint16_t* b) {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+        const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b));
+        const __m256i lo = _mm256_add_epi32(_mm256_cvtepu16_epi32(_mm256_castsi256_si128(va)),
+                                            _mm256_cvtepu16_epi32(_mm256_castsi256_si128(vb)));
+        const __m256i hi = _mm256_add_epi32(_mm256_cvtepu16_epi32(_mm256_extracti128_si256(va, 1)),
+                                            _mm256_cvtepu16_epi32(_mm256_extracti128_si256(vb, 1)));
+        const __m256i sum = _mm256_add_epi32(_mm256_permute2x128_si256(lo, hi, 0x20),
+                                             _mm256_permute2x128_si256(lo, hi, 0x31));
+        return _mm256_srli_epi32(_mm256_add_epi32(sum, _mm256_set1_epi32(2)), 2);
+    }
+
+    // Tekrarda 4 çıktı pikseli; işlenen çıktı sütunu sayısını döner
+    __attribute__((target("avx2")))
+    uint32_t boxDownsampleAvx2(const uint16_t* a, const uint16_t* b, uint32_t sourceWidth, uint16_t* out) {
+        const uint32_t pairs = sourceWidth / 2;
+        uint32_t x = 0;
+        for (; x + 4 <= pairs; x += 4) {
+            const size_t at = static_cast<size_t>(2 * x) * kSamples;
+            const __m256i first = boxPairAvx2(a + at, b + at);
+            const __m256i second = boxPairAvx2(a + at + 4 * kSamples, b + at + 4 * kSamples);
+            // packus yarı yarı paketler: [0, 2 | 1, 3] -> [0, 1, 2, 3]
+            const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(first, second), 0xD8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + static_cast<size_t>(x) * kSamples), packed);
+        }
+        return x;
+    }
+#endif
+
+    void boxDownsample(const uint16_t* a, const uint16_t* b, uint32_t sourceWidth, uint16_t* out) {
+        uint32_t done = 0;
+#if defined(TIFF_AVX2)
+        static const bool supported = __builtin_cpu_supports("avx2");
+        if (supported) done = boxDownsampleAvx2(a, b, sourceWidth, out);
+#endif
+        boxDownsampleScalar(a, b, done, sourceWidth, out);
+    }
+
+    // Satır içinde her örnekten soldaki pikselin aynı örneğini çıkar (mod 2^16)
+    void applyHorizontalPredictor(uint16_t* data, uint32_t columns, uint32_t rows, uint32_t samples) {
+        for (uint32_t y = 0; y < rows; ++y) {
+            uint16_t* row = data + static_cast<size_t>(y) * columns * samples;
+            for (size_t i = static_cast<size_t>(columns) * samples - 1; i >= samples; --i) {
+                row[i] = static_cast<uint16_t>(row[i] - row[i - samples]);
+            }
+        }
+    }
+}
+
+bool tiffCompressionIsParallel(TiffCompression compression) {
+    switch (compression) {
+        case TiffCompression::None:
+            return true;
+        case TiffCompression::Deflate:
+#ifdef COLOR_HAVE_ZLIB
+            return true;
+#else
+            return false;
+#endif
+        case TiffCompression::Zstd:
+#ifdef COLOR_HAVE_ZSTD
+            return true;
+#else
+            return false;
+#endif
+        case TiffCompression::Lzw:
+            break;
+    }
+    return false;
+}
+
+TiffWriter::TiffWriter()
+    : tif(nullptr), width(0), height(0), rowsPerBlock(0),
+      parallel(false), bigTiff(false), written(0) {}
+
+TiffWriter::~TiffWriter() {
+    close();
+}
+
+bool TiffWriter::open(const std::string& path, uint32_t imageWidth, uint32_t imageHeight,
+                      const std::vector<uint8_t>& iccProfile, const TiffWriteOptions& writeOptions) {
+    close();
+    options = writeOptions;
+    width = imageWidth;
+    height = imageHeight;
+    written = 0;
+    levels.clear();
+
+    // Piramit seviyeleri tile'lıdır; ana görüntü de aynı tile ızgarasında
+    if (options.pyramid) options.layout = TiffLayout::Tiles;
+    if (options.layout == TiffLayout::Tiles) {
+        // TIFF tile kenarları 16'nın katı olmak zorunda
+        options.tileSize = std::max<uint32_t>(16, (options.tileSize + 15) / 16 * 16);
+    }
+
+    // Alt seviyeler ana görüntünün en fazla üçte biri kadar yer tutar
+    uint64_t rawBytes = static_cast<uint64_t>(width) * height * sizeof(CMYK16);
+    if (options.pyramid) rawBytes += rawBytes / 3;
+    bigTiff = options.bigTiff == BigTiffMode::Always ||
+              (options.bigTiff == BigTiffMode::Auto && rawBytes + iccProfile.size() > kClassicTiffLimit);
+
+    tif = TIFFOpen(path.c_str(), bigTiff ? "w8" : "w");
+    if (!tif) {
+        std::cerr << "TIFF dosyası oluşturulamadı: " << path << std::endl;
+        return false;
+    }
+
+    // Seri kodekte alt seviyelerin tile'ları close'a kadar ham bekler (ana
+    // görüntünün üçte biri); piramitte zlib varsa paralel Deflate'e geçilir
+    if (options.pyramid && !tiffCompressionIsParallel(options.compression) &&
+        tiffCompressionIsParallel(TiffCompression::Deflate)) {
+        options.compression = TiffCompression::Deflate;
+    }
+
+    // Kodek kütüphanesi yoksa libtiff'in kodlayıcısı kullanılır
+    parallel = tiffCompressionIsParallel(options.compression);
+    if (!parallel && !TIFFIsCODECConfigured(tiffCompression(options.compression))) {
+        std::cerr << "TIFF kodeği bulunamadı, LZW kullanılacak" << std::endl;
+        options.compression = TiffCompression::Lzw;
+    }
+
+    if (options.layout == TiffLayout::Tiles) {
+        rowsPerBlock = options.tileSize;
+    } else {
+        uint32_t rows = options.stripRows;
+        if (rows == 0) {
+            // Ayrı düzlemlerde her strip tek kanallıdır
+            const size_t rowBytes = static_cast<size_t>(std::max<uint32_t>(width, 1)) *
+                                    (options.planar ? sizeof(uint16_t) : sizeof(CMYK16));
+            rows = static_cast<uint32_t>(std::max<size_t>(kTargetStripBytes / rowBytes, 1));
+        }
+        rowsPerBlock = std::min(rows, std::max<uint32_t>(height, 1));
+    }
+    setupDirectory(width, height, options.planar);
+
+    // ICC profilini gömme
+    if (!iccProfile.empty()) {
+        TIFFSetField(tif, TIFFTAG_ICCPROFILE, static_cast<uint32_t>(iccProfile.size()), iccProfile.data());
+    }
+
+    if (parallel) {
+        const unsigned threads = options.threads ? options.threads : ThreadPool::hardwareThreads();
+        pool.reset();
+        // Çağıran thread de blok sıkıştırır
+        if (threads > 1) pool.reset(new ThreadPool(threads - 1));
+    }
+
+    if (options.pyramid) {
+        uint32_t levelWidth = width;
+        uint32_t levelHeight = height;
+        while ((levelWidth > options.tileSize || levelHeight > options.tileSize) &&
+               (options.pyramidLevels == 0 || levels.size() < options.pyramidLevels)) {
+            PyramidLevel level;
+            level.sourceWidth = levelWidth;
+            level.sourceHeight = levelHeight;
+            levelWidth = (levelWidth + 1) / 2;
+            levelHeight = (levelHeight + 1) / 2;
+            level.width = levelWidth;
+            level.height = levelHeight;
+            level.pending.resize(static_cast<size_t>(level.sourceWidth) * kSamples);
+            level.band.resize(static_cast<size_t>(options.tileSize) * levelWidth * kSamples);
+            const size_t across = (levelWidth + options.tileSize - 1) / options.tileSize;
+            const size_t down = (levelHeight + options.tileSize - 1) / options.tileSize;
+            level.tiles.resize(across * down);
+            levels.push_back(std::move(level));
+        }
+    }
+    return true;
+}
+
+void TiffWriter::setupDirectory(uint32_t directoryWidth, uint32_t directoryHeight, bool planarConfig) {
+    const bool usePredictor = options.predictor && options.compression != TiffCompression::None;
+
+    TIFFSetField(tif, TIFFTAG_IMAGEWIDTH, directoryWidth);
+    TIFFSetField(tif, TIFFTAG_IMAGELENGTH, directoryHeight);
+    TIFFSetField(tif, TIFFTAG_SAMPLESPERPIXEL, kSamples); // CMYK
+    TIFFSetField(tif, TIFFTAG_BITSPERSAMPLE, 16);          // 16-bit
+    TIFFSetField(tif, TIFFTAG_ORIENTATION, ORIENTATION_TOPLEFT);
+    TIFFSetField(tif, TIFFTAG_PLANARCONFIG, planarConfig ? PLANARCONFIG_SEPARATE : PLANARCONFIG_CONTIG);
+    TIFFSetField(tif, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_SEPARATED); // CMYK
+    TIFFSetField(tif, TIFFTAG_COMPRESSION, tiffCompression(options.compression));
+    if (usePredictor) TIFFSetField(tif, TIFFTAG_PREDICTOR, PREDICTOR_HORIZONTAL);
+    if (!parallel && options.compression == TiffCompression::Deflate)
+        TIFFSetField(tif, TIFFTAG_ZIPQUALITY, options.deflateLevel);
+
+    if (options.layout == TiffLayout::Tiles) {
+        TIFFSetField(tif, TIFFTAG_TILEWIDTH, options.tileSize);
+        TIFFSetField(tif, TIFFTAG_TILELENGTH, options.tileSize);
+    } else {
+        TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP, rowsPerBlock);
+    }
+}
+
+bool TiffWriter::compressBlock(const uint16_t* source, size_t sourceStride, uint32_t samples,
+                               uint32_t columns, uint32_t rows,
+                               uint32_t blockWidth, uint32_t blockHeight,
+                               std::vector<uint16_t>& scratch, std::vector<uint8_t>& out) const {
+    // Tile kenarlarında eksik kalan alan sıfırla doldurulur
+    const size_t blockSamples = static_cast<size_t>(blockWidth) * blockHeight * samples;
+    scratch.assign(blockSamples, 0);
+    for (uint32_t y = 0; y < rows; ++y) {
+        std::memcpy(scratch.data() + static_cast<size_t>(y) * blockWidth * samples,
+                    source + y * sourceStride, static_cast<size_t>(columns) * samples * sizeof(uint16_t));
+    }
+
+    const bool usePredictor = options.predictor && options.compression != TiffCompression::None;
+    if (usePredictor) applyHorizontalPredictor(scratch.data(), blockWidth, blockHeight, samples);
+
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(scratch.data());
+    const size_t size = blockSamples * sizeof(uint16_t);
+
+    switch (options.compression) {
+        case TiffCompression::None:
+            out.assign(bytes, bytes + size);
+            return true;
+#ifdef COLOR_HAVE_ZLIB
+        case TiffCompression::Deflate: {
+            uLongf capacity = compressBound(static_cast<uLong>(size));
+            out.resize(capacity);
+            if (compress2(out.data(), &capacity, bytes, static_cast<uLong>(size), options.deflateLevel) != Z_OK)
+                return false;
+            out.resize(capacity);
+            return true;
+        }
+#endif
+#ifdef COLOR_HAVE_ZSTD
+        case TiffCompression::Zstd: {
+            out.resize(ZSTD_compressBound(size));
+            size_t result = ZSTD_compress(out.data(), out.size(), bytes, size, options.zstdLevel);
+            if (ZSTD_isError(result)) return false;
+            out.resize(result);
+            return true;
+        }
+#endif
+        default:
+            return false;
+    }
+}
+
+bool TiffWriter::writeRows(uint32_t firstRow, uint32_t rows, const CMYK16* pixels) {
+    return writeRows(firstRow, rows, pixels, nullptr);
+}
+
+bool TiffWriter::writeRows(uint32_t firstRow, uint32_t rows, const CMYK16* pixels,
+                           const std::vector<uint8_t>* const* encoded) {
+    if (options.planar) {
+        std::cerr << "TIFF ayrı düzlemli açıldı, writePlanes kullanılmalı" << std::endl;
+        return false;
+    }
+    if (encoded && !levels.empty()) {
+        // Hazır blokların pikselleri piramide verilemez
+        std::cerr << "Hazır bloklar piramitli TIFF'te kullanılamaz" << std::endl;
+        return false;
+    }
+    const uint16_t* sources[1] = {reinterpret_cast<const uint16_t*>(pixels)};
+    if (!writeBlocks(firstRow, rows, sources, 1, kSamples, encoded)) return false;
+
+    if (!levels.empty()) {
+        const uint16_t* row = sources[0];
+        for (uint32_t r = 0; r < rows; ++r, row += static_cast<size_t>(width) * kSamples) {
+            if (!addLevelRow(0, row)) return false;
+        }
+    }
+    return true;
+}
+
+bool TiffWriter::writePlanes(uint32_t firstRow, uint32_t rows, const CMYKPlanes& planes) {
+    if (!options.planar) {
+        std::cerr << "TIFF bitişik açıldı, writeRows kullanılmalı" << std::endl;
+        return false;
+    }
+    const uint16_t* sources[kSamples];
+    for (int c = 0; c < kSamples; ++c) sources[c] = static_cast<const uint16_t*>(planes.planes[c]);
+    if (!writeBlocks(firstRow, rows, sources, kSamples, 1)) return false;
+
+    // Piramit seviyeleri bitişik yazılır; satırlar tek tek birleştirilir
+    if (!levels.empty()) {
+        interleaved.resize(static_cast<size_t>(width) * kSamples);
+        for (uint32_t r = 0; r < rows; ++r) {
+            const size_t offset = static_cast<size_t>(r) * width;
+            for (uint32_t x = 0; x < width; ++x) {
+                for (int c = 0; c < kSamples; ++c) {
+                    interleaved[static_cast<size_t>(x) * kSamples + c] = sources[c][offset + x];
+                }
+            }
+            if (!addLevelRow(0, interleaved.data())) return false;
+        }
+    }
+    return true;
+}
+
+bool TiffWriter::addLevelRow(size_t index, const uint16_t* row) {
+    PyramidLevel& level = levels[index];
+    const size_t sourceSamples = static_cast<size_t>(level.sourceWidth) * kSamples;
+
+    // Çift satırlar eşini bekler; tek yükseklikte son satır kendisiyle eşleşir
+    const uint16_t* second = row;
+    if (level.sourceRows++ % 2 == 0) {
+        std::memcpy(level.pending.data(), row, sourceSamples * sizeof(uint16_t));
+        if (level.sourceRows < level.sourceHeight) return true;
+        second = level.pending.data();
+    }
+
+    const uint32_t tile = options.tileSize;
+    uint16_t* out = level.band.data() + static_cast<size_t>(level.rows % tile) * level.width * kSamples;
+    boxDownsample(level.pending.data(), second, level.sourceWidth, out);
+    ++level.rows;
+
+    if (index + 1 < levels.size() && !addLevelRow(index + 1, out)) return false;
+    if (level.rows % tile == 0 || level.rows == level.height) return flushLevelBand(level);
+    return true;
+}
+
+bool TiffWriter::flushLevelBand(PyramidLevel& level) {
+    const uint32_t tile = options.tileSize;
+    const uint32_t top = (level.rows - 1) / tile * tile;
+    const uint32_t bandRows = level.rows - top;
+    const uint32_t across = (level.width + tile - 1) / tile;
+    const size_t first = static_cast<size_t>(top / tile) * across;
+    const size_t rowSamples = static_cast<size_t>(level.width) * kSamples;
+
+    std::atomic<bool> ok(true);
+    auto compressRange = [&](size_t begin, size_t end) {
+        thread_local std::vector<uint16_t> scratch;
+        for (size_t t = begin; t < end && ok; ++t) {
+            const uint32_t x = static_cast<uint32_t>(t) * tile;
+            const uint32_t columns = std::min(tile, level.width - x);
+            const uint16_t* source = level.band.data() + static_cast<size_t>(x) * kSamples;
+            std::vector<uint8_t>& out = level.tiles[first + t];
+            if (parallel) {
+                if (!compressBlock(source, rowSamples, kSamples, columns, bandRows, tile, tile, scratch, out))
+                    ok = false;
+                continue;
+            }
+            // Seri kodekte libtiff close'da kodlar; ham, sıfır dolgulu tile
+            out.assign(static_cast<size_t>(tile) * tile * sizeof(CMYK16), 0);
+            for (uint32_t y = 0; y < bandRows; ++y) {
+                std::memcpy(out.data() + static_cast<size_t>(y) * tile * sizeof(CMYK16), source + y * rowSamples,
+                            static_cast<size_t>(columns) * sizeof(CMYK16));
+            }
+        }
+    };
+    if (pool && across > 1) pool->parallelFor(across, 1, compressRange);
+    else compressRange(0, across);
+
+    if (!ok) {
+        std::cerr << "TIFF sıkıştırma hatası" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool TiffWriter::writeLevels() {
+    for (PyramidLevel& level : levels) {
+        if (level.rows != level.height) {
+            std::cerr << "TIFF piramidi eksik: görüntünün tüm satırları yazılmadı" << std::endl;
+            return false;
+        }
+        // Önceki dizini kapat; sonuncusunu TIFFClose yazar
+        if (!TIFFWriteDirectory(tif)) {
+            std::cerr << "TIFF dizini yazılamadı" << std::endl;
+            return false;
+        }
+        setupDirectory(level.width, level.height, false);
+        TIFFSetField(tif, TIFFTAG_SUBFILETYPE, FILETYPE_REDUCEDIMAGE);
+
+        // Bitişik düzende tile dizini satır sırasıyla tile numarasıdır
+        for (size_t t = 0; t < level.tiles.size(); ++t) {
+            std::vector<uint8_t>& data = level.tiles[t];
+            const tmsize_t size = static_cast<tmsize_t>(data.size());
+            const uint32_t index = static_cast<uint32_t>(t);
+            const tmsize_t result = parallel ? TIFFWriteRawTile(tif, index, data.data(), size)
+                                             : TIFFWriteEncodedTile(tif, index, data.data(), size);
+            if (parallel ? result != size : result < 0) {
+                std::cerr << "TIFF yazma hatası" << std::endl;
+                return false;
+            }
+            written += static_cast<uint64_t>(result);
+            std::vector<uint8_t>().swap(data);
+        }
+    }
+    return true;
+}
+
+
+bool TiffWriter::writeBlocks(uint32_t firstRow, uint32_t rows, const uint16_t* const* sources,
+                             uint32_t planeCount, uint32_t samples, const std::vector<uint8_t>* const* encoded) {
+    if (!tif || rows == 0 || firstRow % rowsPerBlock != 0 || firstRow + rows > height) return false;
+
+    const bool tiles = options.layout == TiffLayout::Tiles;
+    const uint32_t blockWidth = tiles ? options.tileSize : width;
+    const uint32_t across = tiles ? (width + blockWidth - 1) / blockWidth : 1;
+    const uint32_t bands = (rows + rowsPerBlock - 1) / rowsPerBlock;
+    const size_t blocksPerPlane = static_cast<size_t>(bands) * across;
+    const size_t jobs = blocksPerPlane * planeCount;
+    const size_t rowSamples = static_cast<size_t>(width) * samples;
+
+    // j. bloğun düzlemi, kaynak konumu ve boyutu
+    struct Block {
+        uint32_t plane, x, y, columns, rows;
+    };
+    auto blockAt = [&](size_t j) {
+        Block block;
+        block.plane = static_cast<uint32_t>(j / blocksPerPlane);
+        const size_t k = j % blocksPerPlane;
+        block.x = static_cast<uint32_t>(k % across) * blockWidth;
+        block.y = static_cast<uint32_t>(k / across) * rowsPerBlock;
+        block.columns = std::min(blockWidth, width - block.x);
+        block.rows = std::min(rowsPerBlock, rows - block.y);
+        return block;
+    };
+    auto sourceOf = [&](const Block& block) {
+        return sources[block.plane] + static_cast<size_t>(block.y) * rowSamples +
+               static_cast<size_t>(block.x) * samples;
+    };
+    // Ayrı düzlemlerde blok dizini kanalı (sample) da içerir
+    auto blockIndex = [&](const Block& block) -> uint32_t {
+        const uint16_t sample = static_cast<uint16_t>(planeCount > 1 ? block.plane : 0);
+        return tiles ? TIFFComputeTile(tif, block.x, firstRow + block.y, 0, sample)
+                     : TIFFComputeStrip(tif, firstRow + block.y, sample);
+    };
+
+    if (encoded && compressed.size() < jobs) compressed.resize(jobs);
+
+    if (!parallel) {
+        // libtiff kodlar; tahmin edici veriyi yerinde değiştirdiği için kopyalanır
+        for (size_t j = 0; j < jobs; ++j) {
+            const Block block = blockAt(j);
+            const uint32_t blockHeight = tiles ? rowsPerBlock : block.rows;
+            const size_t blockRowSamples = static_cast<size_t>(blockWidth) * samples;
+
+            serialScratch.assign(blockRowSamples * blockHeight, 0);
+            if (encoded && encoded[j]) {
+                // Seri kodekte hazır veri tile'ın kodlanmamış (dolgulu) hali
+                if (encoded[j]->size() != serialScratch.size() * sizeof(uint16_t)) {
+                    std::cerr << "Hazır blok boyutu uyuşmuyor" << std::endl;
+                    return false;
+                }
+                std::memcpy(serialScratch.data(), encoded[j]->data(), encoded[j]->size());
+            } else {
+                const uint16_t* source = sourceOf(block);
+                for (uint32_t r = 0; r < block.rows; ++r) {
+                    std::memcpy(serialScratch.data() + r * blockRowSamples, source + r * rowSamples,
+                                static_cast<size_t>(block.columns) * samples * sizeof(uint16_t));
+                }
+                if (encoded) {
+                    const uint8_t* raw = reinterpret_cast<const uint8_t*>(serialScratch.data());
+                    compressed[j].assign(raw, raw + serialScratch.size() * sizeof(uint16_t));
+                }
+            }
+            const tmsize_t bytes = static_cast<tmsize_t>(serialScratch.size() * sizeof(uint16_t));
+            tmsize_t result = tiles
+                ? TIFFWriteEncodedTile(tif, blockIndex(block), serialScratch.data(), bytes)
+                : TIFFWriteEncodedStrip(tif, blockIndex(block), serialScratch.data(), bytes);
+            if (result < 0) {
+                std::cerr << "TIFF yazma hatası" << std::endl;
+                return false;
+            }
+            written += static_cast<uint64_t>(result);
+        }
+        return true;
+    }
+
+    // Blokları paralel sıkıştır, sonra dosya sırasıyla yaz
+    if (compressed.size() < jobs) compressed.resize(jobs);
+    std::atomic<bool> ok(true);
+    auto compressRange = [&](size_t begin, size_t end) {
+        thread_local std::vector<uint16_t> scratch;
+        for (size_t j = begin; j < end && ok; ++j) {
+            if (encoded && encoded[j]) continue;
+            const Block block = blockAt(j);
+            const uint32_t blockHeight = tiles ? rowsPerBlock : block.rows;
+            if (!compressBlock(sourceOf(block), rowSamples, samples, block.columns, block.rows,
+                               blockWidth, blockHeight, scratch, compressed[j])) {
+                ok = false;
+            }
+        }
+    };
+    if (pool && jobs > 1) pool->parallelFor(jobs, 1, compressRange);
+    else compressRange(0, jobs);
+
+    if (!ok) {
+        std::cerr << "TIFF sıkıştırma hatası" << std::endl;
+        return false;
+    }
+
+    for (size_t j = 0; j < jobs; ++j) {
+        const Block block = blockAt(j);
+        const std::vector<uint8_t>& data = encoded && encoded[j] ? *encoded[j] : compressed[j];
+        const tmsize_t size = static_cast<tmsize_t>(data.size());
+        void* bytes = const_cast<uint8_t*>(data.data());
+        tmsize_t result = tiles ? TIFFWriteRawTile(tif, blockIndex(block), bytes, size)
+                                : TIFFWriteRawStrip(tif, blockIndex(block), bytes, size);
+        if (result != size) {
+            std::cerr << "TIFF yazma hatası" << std::endl;
+            return false;
+        }
+        written += static_cast<uint64_t>(size);
+    }
+    return true;
+}
+
+bool TiffWriter::close() {
+    if (!tif) return true;
+    bool ok = writeLevels();
+    levels.clear();
+    // TIFFClose hata bildirmez; son dizin ve tamponlar burada diske yazılır
+    if (!TIFFFlush(tif)) {
+        std::cerr << "TIFF dosyası diske yazılamadı" << std::endl;
+        ok = false;
+    }
+    TIFFClose(tif);
+    tif = nullptr;
+    return ok;
+}
+
+void TiffWriter::discard() {
+    levels.clear();
+    close();
+}
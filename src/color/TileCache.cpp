@@ -0,0 +1,380 @@
+#include "color/TileCache.hpp"
+#include "color/MappedFile.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <system_error>
+
+namespace {
+    constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ull;
+    constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4Full;
+    constexpr uint64_t kPrime3 = 0x165667B19E3779F9ull;
+    constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ull;
+    constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ull;
+
+    inline uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+    // Okumalar makinenin bayt sırasıyla; özetler yalnızca bu cache içindir
+    inline uint64_t read64(const uint8_t* p) {
+        uint64_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    inline uint32_t read32(const uint8_t* p) {
+        uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    inline uint64_t round(uint64_t acc, uint64_t input) {
+        acc += input * kPrime2;
+        return rotl(acc, 31) * kPrime1;
+    }
+
+    inline uint64_t mergeRound(uint64_t acc, uint64_t value) {
+        acc ^= round(0, value);
+        return acc * kPrime1 + kPrime4;
+    }
+
+    const char kMagic[8] = {'C', 'L', 'R', 'T', 'I', 'L', 'E', 'S'};
+
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t reserved;
+        uint64_t content;
+        uint64_t context;
+    };
+    static_assert(sizeof(FileHeader) == 32, "Tile dosya başlığı 32 bayt olmalı");
+
+    FileHeader headerFor(const TileKey& key) {
+        FileHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = TileCache::kFormatVersion;
+        header.content = key.content;
+        header.context = key.context;
+        return header;
+    }
+
+    // "<content><context>.tile" adından anahtar; uymayan dosyalar yok sayılır
+    bool parseName(const std::string& name, TileKey& key) {
+        if (name.size() != 37 || name.compare(32, 5, ".tile") != 0) return false;
+        unsigned long long content = 0, context = 0;
+        for (size_t i = 0; i < 32; ++i) {
+            if (!std::isxdigit(static_cast<unsigned char>(name[i]))) return false;
+        }
+        if (std::sscanf(name.c_str(), "%16llx%16llx", &content, &context) != 2) return false;
+        key.content = content;
+        key.context = context;
+        return true;
+    }
+
+    // Çıkarılan tile dosyaları kilit bırakıldıktan sonra silinir
+    void removeFiles(const std::vector<std::string>& paths) {
+        std::error_code ec;
+        for (const std::string& path : paths) std::filesystem::remove(path, ec);
+    }
+}
+
+XxHash64::XxHash64(uint64_t hashSeed) : seed(hashSeed), total(0), buffered(0) {
+    lanes[0] = seed + kPrime1 + kPrime2;
+    lanes[1] = seed + kPrime2;
+    lanes[2] = seed;
+    lanes[3] = seed - kPrime1;
+}
+
+void XxHash64::update(const void* data, size_t size) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    total += size;
+
+    if (buffered + size < sizeof(buffer)) {
+        std::memcpy(buffer + buffered, p, size);
+        buffered += size;
+        return;
+    }
+    if (buffered) {
+        const size_t fill = sizeof(buffer) - buffered;
+        std::memcpy(buffer + buffered, p, fill);
+        for (int i = 0; i < 4; ++i) lanes[i] = round(lanes[i], read64(buffer + 8 * i));
+        p += fill;
+        size -= fill;
+        buffered = 0;
+    }
+    // 32 baytlık şeritler dört bağımsız akümülatöre
+    uint64_t v0 = lanes[0], v1 = lanes[1], v2 = lanes[2], v3 = lanes[3];
+    for (; size >= 32; p += 32, size -= 32) {
+        v0 = round(v0, read64(p));
+        v1 = round(v1, read64(p + 8));
+        v2 = round(v2, read64(p + 16));
+        v3 = round(v3, read64(p + 24));
+    }
+    lanes[0] = v0;
+    lanes[1] = v1;
+    lanes[2] = v2;
+    lanes[3] = v3;
+    std::memcpy(buffer, p, size);
+    buffered = size;
+}
+
+uint64_t XxHash64::digest() const {
+    uint64_t h;
+    if (total >= 32) {
+        h = rotl(lanes[0], 1) + rotl(lanes[1], 7) + rotl(lanes[2], 12) + rotl(lanes[3], 18);
+        for (int i = 0; i < 4; ++i) h = mergeRound(h, lanes[i]);
+    } else {
+        h = seed + kPrime5;
+    }
+    h += total;
+
+    const uint8_t* p = buffer;
+    size_t left = buffered;
+    for (; left >= 8; p += 8, left -= 8) {
+        h ^= round(0, read64(p));
+        h = rotl(h, 27) * kPrime1 + kPrime4;
+    }
+    if (left >= 4) {
+        h ^= static_cast<uint64_t>(read32(p)) * kPrime1;
+        h = rotl(h, 23) * kPrime2 + kPrime3;
+        p += 4;
+        left -= 4;
+    }
+    for (; left > 0; ++p, --left) {
+        h ^= *p * kPrime5;
+        h = rotl(h, 11) * kPrime1;
+    }
+
+    h ^= h >> 33;
+    h *= kPrime2;
+    h ^= h >> 29;
+    h *= kPrime3;
+    h ^= h >> 32;
+    return h;
+}
+
+uint64_t XxHash64::hash(const void* data, size_t size, uint64_t seed) {
+    XxHash64 state(seed);
+    state.update(data, size);
+    return state.digest();
+}
+
+TileCache::TileCache(const TileCacheOptions& cacheOptions)
+    : options(cacheOptions), memoryUsed(0), diskUsed(0), diskIndexed(false) {}
+
+std::string TileCache::pathFor(const TileKey& key) const {
+    char name[40];
+    std::snprintf(name, sizeof(name), "%016llx%016llx.tile",
+                  static_cast<unsigned long long>(key.content), static_cast<unsigned long long>(key.context));
+    // İlk iki hex hane alt dizin: tek dizinde on binlerce dosya birikmesin
+    return (std::filesystem::path(options.directory) / std::string(name, 2) / name).string();
+}
+
+void TileCache::insertMemory(const TileKey& key, const Tile& tile) {
+    auto it = memory.find(key);
+    if (it != memory.end()) {
+        memoryOrder.splice(memoryOrder.begin(), memoryOrder, it->second);
+        return;
+    }
+    memoryOrder.push_front(MemoryEntry{key, tile});
+    memory[key] = memoryOrder.begin();
+    memoryUsed += tile->size();
+
+    while (memoryUsed > options.memoryBytes && !memoryOrder.empty()) {
+        const MemoryEntry& oldest = memoryOrder.back();
+        memoryUsed -= oldest.data->size();
+        memory.erase(oldest.key);
+        memoryOrder.pop_back();
+        ++counters.evictions;
+    }
+}
+
+void TileCache::indexDisk() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (diskIndexed || options.directory.empty()) return;
+    }
+
+    // Tarama kilit dışında yürür; aynı anda ilk erişen thread'ler ayrı ayrı
+    // tarayabilir, yalnızca ilk biten dizini kurar
+    struct Found {
+        std::filesystem::file_time_type time;
+        TileKey key;
+        uint64_t size;
+    };
+    std::vector<Found> found;
+    std::error_code ec;
+    for (std::filesystem::recursive_directory_iterator it(options.directory, ec), end; !ec && it != end;
+         it.increment(ec)) {
+        if (!it->is_regular_file(ec)) continue;
+        Found entry;
+        if (!parseName(it->path().filename().string(), entry.key)) continue;
+        entry.size = it->file_size(ec);
+        entry.time = it->last_write_time(ec);
+        if (!ec) found.push_back(entry);
+        ec.clear();
+    }
+
+    // Eskiden yeniye; öne eklendikçe en yenisi başa gelir
+    std::sort(found.begin(), found.end(), [](const Found& a, const Found& b) { return a.time < b.time; });
+
+    std::vector<std::string> evicted;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (diskIndexed) return;
+        diskIndexed = true;
+        for (const Found& entry : found) {
+            if (disk.count(entry.key)) continue;
+            diskOrder.push_front(DiskEntry{entry.key, entry.size});
+            disk[entry.key] = diskOrder.begin();
+            diskUsed += entry.size;
+        }
+        evicted = trimDisk();
+    }
+    removeFiles(evicted);
+}
+
+std::vector<std::string> TileCache::trimDisk() {
+    std::vector<std::string> evicted;
+    while (diskUsed > options.diskBytes && !diskOrder.empty()) {
+        const DiskEntry& oldest = diskOrder.back();
+        evicted.push_back(pathFor(oldest.key));
+        diskUsed -= oldest.size;
+        disk.erase(oldest.key);
+        diskOrder.pop_back();
+        ++counters.evictions;
+    }
+    return evicted;
+}
+
+TileCache::Tile TileCache::find(const TileKey& key) {
+    indexDisk();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = memory.find(key);
+        if (it != memory.end()) {
+            memoryOrder.splice(memoryOrder.begin(), memoryOrder, it->second);
+            ++counters.memoryHits;
+            return it->second->data;
+        }
+        if (options.directory.empty()) {
+            ++counters.misses;
+            return nullptr;
+        }
+        if (!disk.count(key)) {
+            ++counters.misses;
+            return nullptr;
+        }
+    }
+
+    // Dosya kilit dışında okunur; diğer thread'ler belleğe erişmeye devam eder
+    const std::string path = pathFor(key);
+    Tile tile;
+    {
+        MappedFile file;
+        const FileHeader expected = headerFor(key);
+        if (file.open(path) && file.size() >= sizeof(FileHeader) &&
+            std::memcmp(file.data(), &expected, sizeof(expected)) == 0) {
+            tile = std::make_shared<const std::vector<uint8_t>>(file.data() + sizeof(FileHeader),
+                                                                file.data() + file.size());
+        }
+    }
+
+    // Silme ve erişim zamanı da kilit dışında; kilit yalnızca dizini günceller
+    std::error_code ec;
+    if (!tile) {
+        std::cerr << "Tile cache dosyası geçersiz, siliniyor: " << path << std::endl;
+        std::filesystem::remove(path, ec);
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = disk.find(key);
+        if (it != disk.end()) {
+            diskUsed -= it->second->size;
+            diskOrder.erase(it->second);
+            disk.erase(it);
+        }
+        ++counters.misses;
+        return nullptr;
+    }
+
+    // Erişim zamanı sonraki süreçlerin LRU sırası için dosyada tutulur
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = disk.find(key);
+    if (it != disk.end()) diskOrder.splice(diskOrder.begin(), diskOrder, it->second);
+    insertMemory(key, tile);
+    ++counters.diskHits;
+    return tile;
+}
+
+void TileCache::store(const TileKey& key, std::vector<uint8_t> data) {
+    Tile tile = std::make_shared<const std::vector<uint8_t>>(std::move(data));
+    indexDisk();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        insertMemory(key, tile);
+        ++counters.stores;
+        if (options.directory.empty()) return;
+        auto it = disk.find(key);
+        if (it != disk.end()) {
+            diskOrder.splice(diskOrder.begin(), diskOrder, it->second);
+            return;
+        }
+    }
+
+    const std::string path = pathFor(key);
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+    std::random_device random;
+    const std::string temporary = path + ".tmp" + std::to_string(random());
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        const FileHeader header = headerFor(key);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(tile->data()), static_cast<std::streamsize>(tile->size()));
+        if (!file) {
+            std::cerr << "Tile cache dosyası yazılamadı: " << temporary << std::endl;
+            file.close();
+            std::filesystem::remove(temporary, ec);
+            return;
+        }
+    }
+    // Aynı tile'ı yazan başka bir süreç varsa içerik aynıdır; son adlandırma kazanır
+    std::filesystem::rename(temporary, path, ec);
+    if (ec) {
+        std::filesystem::remove(temporary, ec);
+        return;
+    }
+
+    std::vector<std::string> evicted;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (disk.count(key)) return;
+        const uint64_t size = sizeof(FileHeader) + tile->size();
+        diskOrder.push_front(DiskEntry{key, size});
+        disk[key] = diskOrder.begin();
+        diskUsed += size;
+        evicted = trimDisk();
+    }
+    removeFiles(evicted);
+}
+
+void TileCache::clearMemory() {
+    std::lock_guard<std::mutex> lock(mutex);
+    memory.clear();
+    memoryOrder.clear();
+    memoryUsed = 0;
+}
+
+TileCacheStats TileCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    TileCacheStats result = counters;
+    result.memoryBytes = memoryUsed;
+    result.diskBytes = diskUsed;
+    return result;
+}
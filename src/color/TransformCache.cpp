@@ -0,0 +1,187 @@
+#include "color/TransformCache.hpp"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <system_error>
+
+#ifdef COLOR_HAVE_FAST_FLOAT
+#include <lcms2_fast_float.h>
+#include <lcms2_plugin.h>
+#endif
+
+namespace {
+#ifdef COLOR_HAVE_FAST_FLOAT
+    // Eklenti global context yerine ayrı bir context'e kaydedilir ki düz lcms2
+    // transform'ları da (karşılaştırma ve geri dönüş için) oluşturulabilsin.
+    // Süreç boyunca yaşar.
+    cmsContext fastFloatContext() {
+        static cmsContext context = cmsCreateContext(cmsFastFloatExtensions(), nullptr);
+        return context;
+    }
+#endif
+
+    void closeProfile(void* h) {
+        if (h) cmsCloseProfile(h);
+    }
+
+    void deleteTransform(void* h) {
+        if (h) cmsDeleteTransform(h);
+    }
+}
+
+TransformCache& TransformCache::instance() {
+    static TransformCache cache;
+    return cache;
+}
+
+CachedProfile TransformCache::openProfile(const std::string& path) {
+    std::error_code ec;
+    uintmax_t size = std::filesystem::file_size(path, ec);
+    if (ec) {
+        std::cerr << "Profil dosyası bulunamadı: " << path << std::endl;
+        return CachedProfile();
+    }
+    int64_t mtime = static_cast<int64_t>(
+        std::filesystem::last_write_time(path, ec).time_since_epoch().count());
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = files.find(path);
+        if (it != files.end() && it->second.size == size && it->second.mtime == mtime) {
+            ++counters.profileHits;
+            return it->second.profile;
+        }
+    }
+
+    // Dosya bir kez okunur; aynı baytlar hem lcms'e verilir hem gömülmek için saklanır
+    std::shared_ptr<std::vector<uint8_t>> bytes = std::make_shared<std::vector<uint8_t>>(size);
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.read(reinterpret_cast<char*>(bytes->data()), static_cast<std::streamsize>(size))) {
+            std::cerr << "Profil dosyası okunamadı: " << path << std::endl;
+            return CachedProfile();
+        }
+    }
+
+    CachedProfile profile = adopt(std::move(bytes));
+    if (!profile) return profile;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    files[path] = FileEntry{size, mtime, profile};
+    return profile;
+}
+
+CachedProfile TransformCache::openProfileFromMemory(const void* data, size_t size) {
+    if (!data || size == 0) return CachedProfile();
+    const uint8_t* begin = static_cast<const uint8_t*>(data);
+    return adopt(std::make_shared<const std::vector<uint8_t>>(begin, begin + size));
+}
+
+CachedProfile TransformCache::adopt(ProfileData bytes) {
+    cmsHPROFILE h = cmsOpenProfileFromMem(bytes->data(), static_cast<cmsUInt32Number>(bytes->size()));
+    if (!h) return CachedProfile();
+
+    CachedProfile profile;
+    profile.handle = std::shared_ptr<void>(h, closeProfile);
+    profile.data = std::move(bytes);
+    cmsMD5computeID(h);
+    cmsGetHeaderProfileID(h, profile.id.data());
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ++counters.profileMisses;
+    // Farklı yoldan aynı içerik yüklendiyse mevcut handle'ı kullan
+    auto known = profiles.find(profile.id);
+    if (known != profiles.end()) {
+        profile = known->second;
+    } else {
+        profiles[profile.id] = profile;
+    }
+    return profile;
+}
+
+std::shared_ptr<void> TransformCache::getTransform(const CachedProfile& input, cmsUInt32Number inputFormat,
+                                                   const CachedProfile& output, cmsUInt32Number outputFormat,
+                                                   cmsUInt32Number intent, cmsUInt32Number flags,
+                                                   bool allowFastFloat) {
+    if (!input || !output) return nullptr;
+
+    // Paylaşılan transform'da lcms'in tek piksellik cache'i thread'ler arasında yarışır
+    flags |= cmsFLAGS_NOCACHE;
+    const bool fastFloat = allowFastFloat && fastFloatAvailable();
+    TransformKey key(input.id, inputFormat, output.id, outputFormat, intent, flags, fastFloat);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = transforms.find(key);
+        if (it != transforms.end()) {
+            ++counters.transformHits;
+            return it->second;
+        }
+    }
+
+    // Aynı anahtarı bekleyen diğer thread'ler tekrar oluşturmasın
+    std::lock_guard<std::mutex> build(buildMutex);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = transforms.find(key);
+        if (it != transforms.end()) {
+            ++counters.transformHits;
+            return it->second;
+        }
+    }
+
+    cmsHTRANSFORM h = nullptr;
+#ifdef COLOR_HAVE_FAST_FLOAT
+    if (fastFloat) {
+        h = cmsCreateTransformTHR(fastFloatContext(),
+                                  input.get(), inputFormat,
+                                  output.get(), outputFormat,
+                                  intent, flags);
+    }
+#endif
+    if (!h) {
+        h = cmsCreateTransform(input.get(), inputFormat,
+                               output.get(), outputFormat,
+                               intent, flags);
+    }
+    if (!h) return nullptr;
+
+    std::shared_ptr<void> transform(h, deleteTransform);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ++counters.transformMisses;
+    transforms[key] = transform;
+    return transform;
+}
+
+bool TransformCache::fastFloatAvailable() {
+#ifdef COLOR_HAVE_FAST_FLOAT
+    return fastFloatContext() != nullptr;
+#else
+    return false;
+#endif
+}
+
+TransformEngine TransformCache::engineOf(cmsHTRANSFORM transform) {
+#ifdef COLOR_HAVE_FAST_FLOAT
+    // Eklentinin üstlendiği transform'lar kendi çalışma verisini UserData'ya
+    // koyar; çekirdek lcms2 transform'larında bu alan boştur.
+    if (transform && _cmsGetTransformUserData(static_cast<struct _cmstransform_struct*>(transform)))
+        return TransformEngine::FastFloat;
+#else
+    (void)transform;
+#endif
+    return TransformEngine::Lcms;
+}
+
+TransformCache::Stats TransformCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return counters;
+}
+
+void TransformCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    files.clear();
+    profiles.clear();
+    transforms.clear();
+    counters = Stats();
+}
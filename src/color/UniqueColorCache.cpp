@@ -0,0 +1,167 @@
+#include "color/UniqueColorCache.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+    // Blok boyutu: indeksler (8 KB) ve yeni renk buffer'ı L1'de kalır
+    constexpr size_t kBlockPixels = 4096;
+
+    constexpr size_t kSamples = 4096;
+    constexpr size_t kSampleSlots = 8192;
+    constexpr unsigned kSampleShift = 64 - 13;
+
+    // Renk başına ortalama bu kadar piksel yoksa cache kazandırmaz
+    constexpr double kMinPixelsPerColor = 8.0;
+
+    constexpr uint64_t kEmpty = ~uint64_t(0);
+    constexpr unsigned kIndexBits = 16;
+    constexpr uint64_t kIndexMask = (uint64_t(1) << kIndexBits) - 1;
+
+    // Fibonacci hash; üst bitler yuva indeksidir
+    inline size_t slotOf(uint64_t key, unsigned shift) {
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> shift);
+    }
+
+    // Alfa kanalı dönüşümde yok sayıldığı için anahtara girmez
+    inline uint64_t packKey(const uint8_t* pixel, PixelFormat format) {
+        if (format == PixelFormat::RGB16) {
+            uint16_t rgb[3];
+            std::memcpy(rgb, pixel, sizeof(rgb));
+            return uint64_t(rgb[0]) | (uint64_t(rgb[1]) << 16) | (uint64_t(rgb[2]) << 32);
+        }
+        return uint64_t(pixel[0]) | (uint64_t(pixel[1]) << 8) | (uint64_t(pixel[2]) << 16);
+    }
+
+    // N renkten düzgün çekilen n örnekte beklenen farklı renk sayısı
+    // N * (1 - e^(-n/N)); gözlenen distinct için N ikiye bölmeyle çözülür
+    double estimateColors(size_t samples, size_t distinct) {
+        if (distinct >= samples) return INFINITY;
+        double low = static_cast<double>(distinct);
+        double high = low;
+        auto expected = [&](double colors) { return colors * -std::expm1(-static_cast<double>(samples) / colors); };
+        while (expected(high) < distinct) high *= 2;
+        for (int i = 0; i < 40; ++i) {
+            const double mid = 0.5 * (low + high);
+            if (expected(mid) < distinct) low = mid;
+            else high = mid;
+        }
+        return high;
+    }
+
+    template <size_t Bytes>
+    void scatter(const uint8_t* results, const uint16_t* indices, uint8_t* out, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            std::memcpy(out + i * Bytes, results + static_cast<size_t>(indices[i]) * Bytes, Bytes);
+        }
+    }
+}
+
+UniqueColorCache::UniqueColorCache(PixelFormat inputFormat, PixelFormat outputFormat,
+                                   size_t maxColors, size_t expectedPixels)
+    : inFormat(inputFormat),
+      inPixel(bytesPerPixel(inputFormat)), outPixel(bytesPerPixel(outputFormat)),
+      limit(std::min({maxColors, kMaxColors, std::max<size_t>(expectedPixels, 1)})),
+      colorCount(0), full(false) {
+    // Doluluk en fazla %50: sondalar kısa kalır
+    size_t capacity = 64;
+    shift = 64 - 6;
+    while (capacity < 2 * limit) {
+        capacity *= 2;
+        --shift;
+    }
+    slots.assign(capacity, kEmpty);
+    results.reserve(std::min<size_t>(limit, 4096) * outPixel);
+    pending.resize(kBlockPixels * inPixel);
+    indices.resize(kBlockPixels);
+}
+
+bool UniqueColorCache::looksFlat(const void* input, PixelFormat inputFormat, size_t pixelCount,
+                                 size_t maxColors) {
+    if (pixelCount == 0 || maxColors == 0) return false;
+    const uint8_t* in = static_cast<const uint8_t*>(input);
+    const size_t pixel = bytesPerPixel(inputFormat);
+    const size_t samples = std::min(pixelCount, kSamples);
+    const size_t step = pixelCount / samples;
+
+    std::vector<uint64_t> seen(kSampleSlots, kEmpty);
+    size_t distinct = 0;
+    for (size_t s = 0; s < samples; ++s) {
+        const uint64_t key = packKey(in + s * step * pixel, inputFormat);
+        for (size_t slot = slotOf(key, kSampleShift);; slot = (slot + 1) & (kSampleSlots - 1)) {
+            if (seen[slot] == key) break;
+            if (seen[slot] == kEmpty) {
+                seen[slot] = key;
+                ++distinct;
+                break;
+            }
+        }
+    }
+
+    const double colors = estimateColors(samples, distinct);
+    return colors <= static_cast<double>(std::min(maxColors, kMaxColors)) &&
+           colors * kMinPixelsPerColor <= static_cast<double>(pixelCount);
+}
+
+uint64_t UniqueColorCache::keyOf(const uint8_t* pixel) const {
+    return packKey(pixel, inFormat);
+}
+
+size_t UniqueColorCache::convert(const void* input, void* output, size_t pixelCount,
+                                 const BatchConvert& batch) {
+    if (full) return 0;
+    const uint8_t* in = static_cast<const uint8_t*>(input);
+    uint8_t* out = static_cast<uint8_t*>(output);
+    const size_t mask = slots.size() - 1;
+
+    for (size_t start = 0; start < pixelCount; start += kBlockPixels) {
+        const size_t count = std::min(kBlockPixels, pixelCount - start);
+        const uint8_t* block = in + start * inPixel;
+        const size_t firstNew = colorCount;
+        // Düz alanlarda ardışık pikseller aynı renktir; tabloya hiç gidilmez
+        uint64_t lastKey = kEmpty;
+        uint16_t lastIndex = 0;
+
+        for (size_t i = 0; i < count; ++i) {
+            const uint8_t* pixel = block + i * inPixel;
+            const uint64_t key = keyOf(pixel) << kIndexBits;
+            if (key == lastKey) {
+                indices[i] = lastIndex;
+                continue;
+            }
+            lastKey = key;
+            size_t slot = slotOf(key, shift);
+            for (;;) {
+                const uint64_t entry = slots[slot];
+                if (entry == kEmpty) {
+                    if (colorCount == limit) {
+                        // Düşük kardinalite tahmini tutmadı; bu blok yazılmadı
+                        full = true;
+                        return start;
+                    }
+                    std::memcpy(pending.data() + (colorCount - firstNew) * inPixel, pixel, inPixel);
+                    slots[slot] = key | colorCount;
+                    lastIndex = static_cast<uint16_t>(colorCount++);
+                    break;
+                }
+                if ((entry & ~kIndexMask) == key) {
+                    lastIndex = static_cast<uint16_t>(entry & kIndexMask);
+                    break;
+                }
+                slot = (slot + 1) & mask;
+            }
+            indices[i] = lastIndex;
+        }
+
+        // Bloktaki yeni renkler tek çağrıda dönüştürülür
+        if (colorCount > firstNew) {
+            results.resize(colorCount * outPixel);
+            batch(pending.data(), results.data() + firstNew * outPixel, colorCount - firstNew);
+        }
+
+        uint8_t* dst = out + start * outPixel;
+        if (outPixel == sizeof(CMYK16)) scatter<sizeof(CMYK16)>(results.data(), indices.data(), dst, count);
+        else scatter<sizeof(CMYK8)>(results.data(), indices.data(), dst, count);
+    }
+    return pixelCount;
+}